@@ -0,0 +1,128 @@
+#include "Bench.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include "AnimationLibrary.hpp"
+#include "NPC.hpp"
+#include "Renderer.hpp"
+#include "TextureManager.hpp"
+
+const std::vector<std::string> BENCH_TEXTURES =
+{
+    "assets/sprites/Player/Left_Idle.bmp",
+    "assets/sprites/Player/Right_Idle.bmp"
+};
+
+const AnimationSetDef BENCH_ANIMATION =
+{
+    {AnimState::IdleLeft,  {{BENCH_TEXTURES[0]}, 10.0f, {}}},
+    {AnimState::IdleRight, {{BENCH_TEXTURES[1]}, 10.0f, {}}},
+    {AnimState::WalkLeft,  {{BENCH_TEXTURES[0], BENCH_TEXTURES[0]}, 10.0f, {}}},
+    {AnimState::WalkRight, {{BENCH_TEXTURES[1], BENCH_TEXTURES[1]}, 12.0f, {}}}
+};
+
+namespace
+{
+    struct Summary
+    {
+        double mean, min, p50, p90, p99, max;
+    };
+
+    Summary Summarize(const std::vector<double> &samples)
+    {
+        Summary s = {};
+        if (samples.empty())
+            return s;
+        double sum = 0.0;
+        for (double v : samples)
+            sum += v;
+        s.mean = sum / samples.size();
+        s.min = *std::min_element(samples.begin(), samples.end());
+        s.max = *std::max_element(samples.begin(), samples.end());
+        s.p50 = Percentile(samples, 50.0);
+        s.p90 = Percentile(samples, 90.0);
+        s.p99 = Percentile(samples, 99.0);
+        return s;
+    }
+}
+
+double Percentile(std::vector<double> samples, double p)
+{
+    if (samples.empty())
+        return 0.0;
+    std::sort(samples.begin(), samples.end());
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * samples.size()));
+    return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+}
+
+void BenchReport::Add(const std::string &name, int entities, const std::vector<double> &samplesMs)
+{
+    results.push_back({name, entities, samplesMs});
+    Summary s = Summarize(samplesMs);
+    std::cout << "  " << std::left << std::setw(28) << name << std::right << std::setw(8) << entities
+              << std::fixed << std::setprecision(3)
+              << "  mean " << std::setw(9) << s.mean << " ms"
+              << "  p50 " << std::setw(9) << s.p50 << " ms"
+              << "  p99 " << std::setw(9) << s.p99 << " ms" << std::endl;
+}
+
+bool BenchReport::WriteJson(const std::string &path) const
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+    out << std::setprecision(6) << "{\n  \"unit\": \"ms\",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchResult &r = results[i];
+        Summary s = Summarize(r.samplesMs);
+        out << "    { \"name\": \"" << r.name << "\", \"entities\": " << r.entities
+            << ", \"samples\": " << r.samplesMs.size()
+            << ", \"mean\": " << s.mean << ", \"min\": " << s.min
+            << ", \"p50\": " << s.p50 << ", \"p90\": " << s.p90
+            << ", \"p99\": " << s.p99 << ", \"max\": " << s.max << " }"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+AnimationSetRef BenchAnimation()
+{
+    return AnimationLibrary::Instance().Load("Bench", BENCH_ANIMATION);
+}
+
+std::vector<GameObject*> SpawnNPCs(int count, float worldSize, const AnimationSetRef &animation, SDL_Renderer *sdlRenderer)
+{
+    std::mt19937 rng(1234);
+    if (worldSize <= 0.0f)
+        worldSize = std::sqrt(static_cast<float>(count)) * BENCH_SPACING;
+    std::uniform_real_distribution<float> pos(0.0f, worldSize);
+    std::uniform_real_distribution<float> vel(-BENCH_NPC_SPEED, BENCH_NPC_SPEED);
+    std::vector<GameObject*> npcs;
+    npcs.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        NPC *npc = new NPC(pos(rng), pos(rng), 44.0f, 66.0f, animation, BENCH_NPC_SPEED);
+        npc->SetVX(vel(rng));
+        npc->SetVY(vel(rng));
+        npcs.push_back(npc);
+    }
+    // Benchmarks measure drawing the real sprites, not the streaming placeholder
+    if (sdlRenderer)
+        TextureManager::Instance().FinishLoading(sdlRenderer);
+    return npcs;
+}
+
+bool InitOffscreenRenderer(int width, int height)
+{
+    if (Renderer::Instance().GetSDLRenderer())
+        return true;
+    SDL_Surface *target = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_ARGB8888);
+    if (!target)
+        return false;
+    return Renderer::Instance().Init(SDL_CreateSoftwareRenderer(target));
+}
@@ -0,0 +1,137 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "AnimationSet.hpp"
+#include "GameObject.hpp"
+
+/**
+ * Shared helpers for the Arrow2D_bench executable.
+ *
+ * Each benchmark file exposes one Run*Benchmarks() entry point that main() calls in turn.
+ * Results are collected in a BenchReport, printed as they arrive, and written as JSON at
+ * the end so runs can be compared across commits.
+ */
+
+constexpr float BENCH_DT = 1.0f / 60.0f;
+constexpr float BENCH_SPACING = 96.0f; // Average distance between spawned NPCs
+constexpr float BENCH_NPC_SPEED = 120.0f;
+
+/// @brief Sprites that ship as BMPs, used by every benchmark that draws.
+extern const std::vector<std::string> BENCH_TEXTURES;
+
+/// @brief Clips for every animation state, built from BENCH_TEXTURES.
+extern const AnimationSetDef BENCH_ANIMATION;
+
+/**
+ * @struct BenchOptions
+ * @brief Command-line options shared by all benchmarks.
+ */
+struct BenchOptions
+{
+    bool quick = false;                      // Skip the largest sizes and take fewer samples
+    std::string jsonPath = "bench_output.json"; // Where to write the JSON report
+    std::string archivePath;                 // Asset archive to compare cold loads against, if any
+};
+
+/**
+ * @struct BenchResult
+ * @brief All samples of one benchmark case.
+ */
+struct BenchResult
+{
+    std::string name;              // Case name, e.g. "scene_update"
+    int entities = 0;              // Entity count the case ran with (0 if not applicable)
+    std::vector<double> samplesMs; // One timing per iteration, in milliseconds
+};
+
+/**
+ * @class BenchReport
+ * @brief Collects benchmark results and writes them as JSON with summary percentiles.
+ */
+class BenchReport
+{
+    public:
+        /**
+         * @brief Records a result and prints a one-line summary.
+         */
+        void Add(const std::string &name, int entities, const std::vector<double> &samplesMs);
+
+        /**
+         * @brief Writes every result to a JSON file.
+         *
+         * Each entry has the case name, entity count, sample count and the mean, min, p50, p90,
+         * p99 and max of the samples in milliseconds.
+         *
+         * @return true if the file was written.
+         */
+        bool WriteJson(const std::string &path) const;
+
+    private:
+        std::vector<BenchResult> results;
+};
+
+/**
+ * @brief Returns the p-th percentile (0-100) of the samples, using the nearest-rank method.
+ */
+double Percentile(std::vector<double> samples, double p);
+
+/**
+ * @brief Times @p iterations calls of @p fn.
+ * @return One sample per call, in milliseconds.
+ */
+template <typename Fn>
+std::vector<double> Sample(int iterations, Fn fn)
+{
+    std::vector<double> samples;
+    samples.reserve(iterations);
+    const double toMs = 1000.0 / SDL_GetPerformanceFrequency();
+    for (int i = 0; i < iterations; ++i)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        fn();
+        samples.push_back((SDL_GetPerformanceCounter() - start) * toMs);
+    }
+    return samples;
+}
+
+/**
+ * @brief Creates standalone NPCs at random positions with random velocities.
+ *
+ * The same seed always produces the same NPCs.
+ *
+ * @param count Number of NPCs to create.
+ * @param worldSize Side of the square the NPCs are spread over, or 0 to grow it with @p count
+ *                  so the density (and therefore the number of collisions) stays constant.
+ * @param animation Shared clips for every NPC, may be nullptr.
+ * @param sdlRenderer Renderer the textures are uploaded with before returning, may be nullptr when no animation is given.
+ * @return The new NPCs; the caller takes ownership.
+ */
+std::vector<GameObject*> SpawnNPCs(int count, float worldSize = 0.0f, const AnimationSetRef &animation = nullptr, SDL_Renderer *sdlRenderer = nullptr);
+
+/**
+ * @brief Gets the shared animation set built from BENCH_ANIMATION, building it if nothing holds it.
+ */
+AnimationSetRef BenchAnimation();
+
+/**
+ * @brief Creates an offscreen software renderer and installs it in the Renderer singleton.
+ * @return true on success.
+ */
+bool InitOffscreenRenderer(int width, int height);
+
+void RunCollisionBenchmarks(const BenchOptions &options, BenchReport &report);
+void RunEntityStoreBenchmarks(const BenchOptions &options, BenchReport &report);
+void RunSceneBenchmarks(const BenchOptions &options, BenchReport &report);
+void RunTextureBenchmarks(const BenchOptions &options, BenchReport &report);
+void RunPoolBenchmarks(const BenchOptions &options, BenchReport &report);
+void RunTilemapBenchmarks(const BenchOptions &options, BenchReport &report);
+void RunInputBenchmarks(const BenchOptions &options, BenchReport &report);
+void RunSceneFileBenchmarks(const BenchOptions &options, BenchReport &report);
+void RunWorldBenchmarks(const BenchOptions &options, BenchReport &report);
+void RunSceneStackBenchmarks(const BenchOptions &options, BenchReport &report);
+
+#endif // BENCH_HPP
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "Bench.hpp"
+#include "NPC.hpp"
+#include "Scene.hpp"
+#include "JobSystem.hpp"
+
+/**
+ * Collision benchmark for Scene::Update.
+ *
+ * Spawns N moving NPCs at a constant density and times Scene::Update with the job system's
+ * workers, on the main thread alone, and as an all-pairs scan on identical copies, then
+ * compares the final positions to check that threading and the broadphase change nothing.
+ * A tunneling check first fires a fast box at a thin wall to check it stops at contact.
+ */
+
+namespace
+{
+    /// @brief Scene that exposes its objects so the benchmark can inspect them.
+    class BenchScene : public Scene
+    {
+        public:
+            const std::vector<GameObject*>& GetObjects() const { return entities.owner; } // Insertion order while nothing is despawned
+    };
+
+    /// @brief Scene::Update's movement rules as a single-threaded all-pairs scan, kept as a reference.
+    void BruteForceUpdate(std::vector<GameObject*>& objects, float dt)
+    {
+        // Every check sees the step's starting state: old hitboxes grown to cover the intended move
+        std::vector<SDL_FRect> swept(objects.size());
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            SDL_FRect h = objects[i]->GetHitbox();
+            float tryX = objects[i]->GetX() + objects[i]->GetVX() * dt;
+            float tryY = objects[i]->GetY() + objects[i]->GetVY() * dt;
+            float x0 = std::min(h.x, tryX), y0 = std::min(h.y, tryY);
+            swept[i] = { x0, y0, std::max(h.x, tryX) + h.w - x0, std::max(h.y, tryY) + h.h - y0 };
+        }
+
+        std::vector<float> newX(objects.size()), newY(objects.size());
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            GameObject* obj = objects[i];
+            SDL_FRect box = obj->GetHitbox();
+            float dx = (obj->GetX() + obj->GetVX() * dt) - obj->GetX();
+            float dy = (obj->GetY() + obj->GetVY() * dt) - obj->GetY();
+            for (int pass = 0; pass < 2 && (dx != 0.0f || dy != 0.0f); ++pass)
+            {
+                // Earliest contact over every other object; ties go to the lower index (= entity ID)
+                SweepHit first;
+                size_t firstIndex = 0;
+                for (size_t j = 0; j < objects.size(); ++j)
+                {
+                    if (j == i)
+                        continue;
+                    SweepHit hit = GameObject::Sweep(box, dx, dy, swept[j]);
+                    if (hit.Hit() && (hit.time < first.time || (hit.time == first.time && j < firstIndex)))
+                    {
+                        first = hit;
+                        firstIndex = j;
+                    }
+                }
+                box.x += dx * first.time;
+                box.y += dy * first.time;
+                if (!first.Hit())
+                    break;
+                const SDL_FRect& r = swept[firstIndex];
+                if (first.time > 0.0f)
+                {
+                    if (first.normalX != 0.0f)
+                        box.x = first.normalX < 0.0f ? r.x - box.w : r.x + r.w;
+                    else
+                        box.y = first.normalY < 0.0f ? r.y - box.h : r.y + r.h;
+                }
+                float rest = 1.0f - first.time;
+                dx = first.normalX != 0.0f ? 0.0f : dx * rest;
+                dy = first.normalY != 0.0f ? 0.0f : dy * rest;
+            }
+            newX[i] = box.x;
+            newY[i] = box.y;
+        }
+
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            GameObject* obj = objects[i];
+            obj->SetX(newX[i]);
+            obj->SetY(newY[i]);
+            SDL_FRect newHitbox = obj->GetHitbox();
+            newHitbox.x = newX[i];
+            newHitbox.y = newY[i];
+            obj->SetHitbox(newHitbox);
+            obj->Update(dt);
+        }
+    }
+
+    /// @brief Counts objects whose positions differ between two runs.
+    int CountMismatches(const std::vector<GameObject*>& a, const std::vector<GameObject*>& b)
+    {
+        int mismatches = 0;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i]->GetX() != b[i]->GetX() || a[i]->GetY() != b[i]->GetY())
+                ++mismatches;
+        }
+        return mismatches;
+    }
+
+    /// @brief Fires a small box at a thin wall far faster than its own width per step.
+    void RunTunnelingCheck()
+    {
+        BenchScene scene;
+        GameObject* wall = scene.Spawn<NPC>(500.0f, 0.0f, 4.0f, 200.0f, nullptr, 0.0f);
+        GameObject* bullet = scene.Spawn<NPC>(0.0f, 50.0f, 8.0f, 8.0f, nullptr, 0.0f);
+        bullet->SetVX(1000.0f / BENCH_DT); // 1000 px per step, over 100 times its width
+        bullet->SetVY(10.0f / BENCH_DT);
+        scene.Update(BENCH_DT);
+        bool atContact = bullet->GetX() + bullet->GetWidth() == wall->GetX();
+        std::cout << "  tunneling check: bullet " << (atContact ? "stopped at the wall" : "MISSED the wall")
+                  << " (x " << bullet->GetX() << ", y " << bullet->GetY() << ")" << std::endl;
+    }
+
+    void RunCollisionBench(int count, int frames, BenchReport &report)
+    {
+        JobSystem& jobs = JobSystem::Instance();
+        int workers = jobs.GetWorkerCount();
+
+        BenchScene scene;
+        for (GameObject* npc : SpawnNPCs(count))
+            scene.AddObject(npc);
+        report.Add("collision_grid", count, Sample(frames, [&]() { scene.Update(BENCH_DT); }));
+
+        // Same run on the main thread only; positions must match the threaded run exactly
+        jobs.Init(0);
+        BenchScene serialScene;
+        for (GameObject* npc : SpawnNPCs(count))
+            serialScene.AddObject(npc);
+        report.Add("collision_grid_1_thread", count, Sample(frames, [&]() { serialScene.Update(BENCH_DT); }));
+        jobs.Init(workers);
+
+        std::vector<GameObject*> reference = SpawnNPCs(count);
+        report.Add("collision_all_pairs", count, Sample(frames, [&]() { BruteForceUpdate(reference, BENCH_DT); }));
+
+        std::cout << "  " << workers << " workers vs. 1 thread position mismatches: "
+                  << CountMismatches(scene.GetObjects(), serialScene.GetObjects()) << std::endl;
+        std::cout << "  grid vs. all-pairs position mismatches: "
+                  << CountMismatches(scene.GetObjects(), reference) << std::endl;
+        for (GameObject* obj : reference)
+            delete obj;
+    }
+}
+
+void RunCollisionBenchmarks(const BenchOptions &options, BenchReport &report)
+{
+    std::cout << "Collision broadphase vs. all-pairs reference" << std::endl;
+    RunTunnelingCheck();
+    RunCollisionBench(1000, options.quick ? 30 : 120, report);
+    if (!options.quick)
+        RunCollisionBench(10000, 5, report);
+}
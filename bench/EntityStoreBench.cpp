@@ -0,0 +1,152 @@
+#include <iostream>
+#include <vector>
+#include "Bench.hpp"
+#include "GameConfig.hpp"
+#include "Renderer.hpp"
+#include "EntityStore.hpp"
+#include "SpatialGrid.hpp"
+#include "TextureManager.hpp"
+
+/**
+ * Before/after benchmark for the structure-of-arrays entity storage.
+ *
+ * Both sides run the same loops, the object-at-a-time update Scene used when it iterated
+ * std::vector<GameObject*> (uniform grid broadphase, per-axis resolve) and an unculled draw of
+ * every object. "Before" reads every field through a separate heap object; "after" reads the
+ * same fields from the EntityStore arrays the objects are attached to. Scene::Update and
+ * Scene::Render have moved on since (swept collision, culling) and are timed in SceneBench.
+ */
+
+namespace
+{
+    constexpr int STORE_BENCH_COUNT = 50000;
+    constexpr int STORE_BENCH_FRAMES = 30;
+
+    /// @brief Object-at-a-time Scene::Update, indexing the grid by position in the vector.
+    void PointerUpdate(std::vector<GameObject*>& objects, SpatialGrid& grid, float dt)
+    {
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            GameObject* obj = objects[i];
+            EntityId id = static_cast<EntityId>(i);
+            SDL_FRect oldHitbox = obj->GetHitbox();
+
+            float tryX = obj->GetX() + obj->GetVX() * dt;
+            SDL_FRect hitboxX = oldHitbox;
+            hitboxX.x = tryX;
+            if (!grid.AnyIntersecting(hitboxX, id))
+                obj->SetX(tryX);
+
+            float tryY = obj->GetY() + obj->GetVY() * dt;
+            SDL_FRect hitboxY = oldHitbox;
+            hitboxY.y = tryY;
+            if (!grid.AnyIntersecting(hitboxY, id))
+                obj->SetY(tryY);
+
+            SDL_FRect newHitbox = oldHitbox;
+            newHitbox.x = obj->GetX();
+            newHitbox.y = obj->GetY();
+            obj->SetHitbox(newHitbox);
+            grid.Move(id, oldHitbox, newHitbox);
+
+            obj->Update(dt);
+        }
+    }
+
+    /// @brief The same update as PointerUpdate(), walking the entity store arrays.
+    void StoreUpdate(EntityStore& e, SpatialGrid& grid, float dt)
+    {
+        for (size_t i = 0; i < e.Size(); ++i)
+        {
+            EntityId id = e.ids[i];
+            SDL_FRect oldHitbox = e.hitbox[i];
+
+            float tryX = e.x[i] + e.vx[i] * dt;
+            SDL_FRect hitboxX = oldHitbox;
+            hitboxX.x = tryX;
+            if (!grid.AnyIntersecting(hitboxX, id))
+                e.x[i] = tryX;
+
+            float tryY = e.y[i] + e.vy[i] * dt;
+            SDL_FRect hitboxY = oldHitbox;
+            hitboxY.y = tryY;
+            if (!grid.AnyIntersecting(hitboxY, id))
+                e.y[i] = tryY;
+
+            SDL_FRect newHitbox = oldHitbox;
+            newHitbox.x = e.x[i];
+            newHitbox.y = e.y[i];
+            e.hitbox[i] = newHitbox;
+            grid.Move(id, oldHitbox, newHitbox);
+
+            e.owner[i]->Update(dt);
+        }
+    }
+
+    /// @brief Draws every entity of the store, without culling.
+    void StoreRender(const EntityStore& e, Renderer& renderer)
+    {
+        const TextureManager& textures = TextureManager::Instance();
+        for (size_t i = 0; i < e.Size(); ++i)
+        {
+            if (!e.animation[i])
+                continue;
+            SDL_FRect dest = { e.x[i], e.y[i], e.width[i], e.height[i] };
+            renderer.RenderTexture(textures.Resolve(e.animation[i]->GetFrameTexture(e.animState[i], e.animFrame[i])), dest, e.layer[i]);
+        }
+    }
+}
+
+void RunEntityStoreBenchmarks(const BenchOptions &options, BenchReport &report)
+{
+    std::cout << "Entity storage before/after" << std::endl;
+    if (!InitOffscreenRenderer(WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        std::cout << "  skipped: could not create offscreen renderer: " << SDL_GetError() << std::endl;
+        return;
+    }
+    Renderer& renderer = Renderer::Instance();
+    SDL_Renderer* sdlRenderer = renderer.GetSDLRenderer();
+    int frames = options.quick ? 10 : STORE_BENCH_FRAMES;
+
+    // Before: standalone objects, one heap allocation each
+    std::vector<GameObject*> objects = SpawnNPCs(STORE_BENCH_COUNT, 0.0f, BenchAnimation(), sdlRenderer);
+    SpatialGrid grid(COLLISION_CELL_SIZE);
+    for (size_t i = 0; i < objects.size(); ++i)
+        grid.Insert(static_cast<EntityId>(i), objects[i]->GetHitbox());
+
+    report.Add("store_update_before", STORE_BENCH_COUNT, Sample(frames, [&]() { PointerUpdate(objects, grid, BENCH_DT); }));
+    report.Add("store_render_before", STORE_BENCH_COUNT, Sample(frames, [&]()
+    {
+        renderer.Clean();
+        for (GameObject* obj : objects)
+            renderer.Render(*obj);
+        renderer.Present();
+    }));
+    for (GameObject* obj : objects)
+        delete obj;
+
+    // After: the same objects attached to an entity store, IDs matching their grid entries
+    objects = SpawnNPCs(STORE_BENCH_COUNT, 0.0f, BenchAnimation(), sdlRenderer);
+    EntityStore store;
+    store.Reserve(objects.size());
+    SpatialGrid storeGrid(COLLISION_CELL_SIZE);
+    for (GameObject* obj : objects)
+    {
+        obj->AttachToStore(&store);
+        storeGrid.Insert(obj->GetEntityId(), obj->GetHitbox());
+    }
+
+    report.Add("store_update_after", STORE_BENCH_COUNT, Sample(frames, [&]() { StoreUpdate(store, storeGrid, BENCH_DT); }));
+    report.Add("store_render_after", STORE_BENCH_COUNT, Sample(frames, [&]()
+    {
+        renderer.Clean();
+        StoreRender(store, renderer);
+        renderer.Present();
+    }));
+    for (GameObject* obj : objects)
+    {
+        obj->DetachFromStore();
+        delete obj;
+    }
+}
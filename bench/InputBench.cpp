@@ -0,0 +1,64 @@
+#include <cmath>
+#include <iostream>
+#include "Bench.hpp"
+#include "GameConfig.hpp"
+#include "InputManager.hpp"
+
+/**
+ * Input query benchmark.
+ *
+ * Times working out a movement vector for many input-driven entities, first the way the
+ * InputManager used to (eight live keyboard-state lookups and a square root per query), then
+ * from the InputManager's per-frame snapshot.
+ */
+
+namespace
+{
+    constexpr int INPUT_QUERIES = 10000;
+
+    /// @brief The previous per-query path, kept as the baseline.
+    void LiveMovementVector(float& vx, float& vy, float speed)
+    {
+        auto isDown = [](SDL_Scancode key) { const bool* state = SDL_GetKeyboardState(NULL); return state != nullptr && state[key]; };
+        vx = 0.0f;
+        vy = 0.0f;
+        if (isDown(KEY_MOVE_UP)    || isDown(KEY_UP_ALT))    vy -= 1.0f;
+        if (isDown(KEY_MOVE_DOWN)  || isDown(KEY_DOWN_ALT))  vy += 1.0f;
+        if (isDown(KEY_MOVE_LEFT)  || isDown(KEY_LEFT_ALT))  vx -= 1.0f;
+        if (isDown(KEY_MOVE_RIGHT) || isDown(KEY_RIGHT_ALT)) vx += 1.0f;
+        float len = sqrtf(vx * vx + vy * vy);
+        if (len > 0.0f)
+        {
+            vx = (vx / len) * speed;
+            vy = (vy / len) * speed;
+        }
+    }
+}
+
+void RunInputBenchmarks(const BenchOptions &options, BenchReport &report)
+{
+    std::cout << "Input queries, live keyboard state vs. per-frame snapshot" << std::endl;
+    int frames = options.quick ? 30 : 120;
+    volatile float sink = 0.0f; // Keeps the loops from being optimized away
+    report.Add("input_live_queries", INPUT_QUERIES, Sample(frames, [&]()
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < INPUT_QUERIES; ++i)
+        {
+            float vx, vy;
+            LiveMovementVector(vx, vy, PLAYER_SPEED);
+            sum += vx + vy;
+        }
+        sink = sink + sum;
+    }));
+
+    InputManager& input = InputManager::Instance();
+    report.Add("input_snapshot_queries", INPUT_QUERIES, Sample(frames, [&]()
+    {
+        const InputSnapshot& snapshot = input.GetSnapshot();
+        float sum = 0.0f;
+        for (int i = 0; i < INPUT_QUERIES; ++i)
+            sum += snapshot.moveX * PLAYER_SPEED + snapshot.moveY * PLAYER_SPEED;
+        sink = sink + sum;
+    }));
+}
@@ -0,0 +1,93 @@
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <vector>
+#include "Bench.hpp"
+#include "NPC.hpp"
+#include "Scene.hpp"
+
+/**
+ * Spawn-churn benchmark for Scene::Spawn / Scene::Despawn.
+ *
+ * Keeps a scene of N NPCs and, every frame, despawns the oldest K and spawns K new ones, as
+ * projectiles or particles would. "heap" creates them with new and Scene::AddObject; "pool"
+ * uses Scene::Spawn, which reuses slots from the scene's object pools. The number of global
+ * allocations per frame is counted by replacing operator new for the benchmark executable.
+ */
+
+namespace
+{
+    constexpr int CHURN_BASE = 10000; // NPCs alive at any time
+    constexpr int CHURN_PER_FRAME = 1000; // NPCs replaced each frame
+
+    std::atomic<Uint64> globalAllocations{0};
+}
+
+void *operator new(size_t size)
+{
+    globalAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+namespace
+{
+    /// @brief Times CHURN_PER_FRAME despawns and spawns per frame, oldest objects first.
+    template <typename SpawnFn>
+    void RunChurnCase(const char *name, int frames, SpawnFn spawn, BenchReport &report)
+    {
+        Scene scene;
+        std::mt19937 rng(1234);
+        float worldSize = std::sqrt(static_cast<float>(CHURN_BASE)) * BENCH_SPACING;
+        std::uniform_real_distribution<float> pos(0.0f, worldSize);
+
+        // Ring of live objects, oldest at head
+        std::vector<GameObject*> live;
+        for (int i = 0; i < CHURN_BASE; ++i)
+            live.push_back(spawn(scene, pos(rng), pos(rng)));
+        size_t head = 0;
+        auto churn = [&]()
+        {
+            for (int i = 0; i < CHURN_PER_FRAME; ++i)
+            {
+                scene.Despawn(live[head]);
+                live[head] = spawn(scene, pos(rng), pos(rng));
+                head = (head + 1) % live.size();
+            }
+        };
+        churn(); // Warm up: grow the entity store and grid buckets to their steady-state size
+
+        Uint64 before = globalAllocations.load(std::memory_order_relaxed);
+        report.Add(name, CHURN_PER_FRAME, Sample(frames, churn));
+        Uint64 allocations = globalAllocations.load(std::memory_order_relaxed) - before;
+
+        Scene::AllocationStats stats = scene.GetAllocationStats();
+        std::cout << "  " << name << ": " << static_cast<double>(allocations) / frames << " global allocations per frame, "
+                  << stats.pools.live << " pooled live / " << stats.pools.capacity << " slots in " << stats.pools.blocks
+                  << " blocks, " << stats.pools.reused << " reused, arena " << stats.arena.blocks << " blocks ("
+                  << stats.arena.bytesUsed / 1024 << " of " << stats.arena.bytesReserved / 1024 << " KiB)" << std::endl;
+    }
+}
+
+void RunPoolBenchmarks(const BenchOptions &options, BenchReport &report)
+{
+    std::cout << "Spawn churn, heap vs. pool" << std::endl;
+    int frames = options.quick ? 10 : 60;
+    RunChurnCase("spawn_churn_heap", frames, [](Scene &scene, float x, float y) -> GameObject*
+    {
+        NPC *npc = new NPC(x, y, 44.0f, 66.0f, nullptr, BENCH_NPC_SPEED);
+        scene.AddObject(npc);
+        return npc;
+    }, report);
+    RunChurnCase("spawn_churn_pool", frames, [](Scene &scene, float x, float y) -> GameObject*
+    {
+        return scene.Spawn<NPC>(x, y, 44.0f, 66.0f, nullptr, BENCH_NPC_SPEED);
+    }, report);
+}
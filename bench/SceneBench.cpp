@@ -0,0 +1,134 @@
+#include <iostream>
+#include <vector>
+#include "Bench.hpp"
+#include "GameConfig.hpp"
+#include "Renderer.hpp"
+#include "Scene.hpp"
+#include "TextureManager.hpp"
+
+/**
+ * Scene hot-loop benchmarks.
+ *
+ * Spawns N NPCs into a Scene and times each per-frame entry point separately:
+ * Scene::Update (movement and collision), Scene::UpdateAnim, and Scene::Render through
+ * the offscreen software renderer. Rendering is measured twice: with the NPCs packed into
+ * one screen (everything drawn) and spread over a large world (mostly culled).
+ * "scene_update_anim_100k" times only the animation system, on 100k sprites that keep moving.
+ * The static scenery cases draw the same sprites as objects and as a StaticLayer, whose
+ * chunks are drawn once and then blitted, and once more with one sprite moved per frame.
+ */
+
+namespace
+{
+    void RunSceneCase(int count, int frames, BenchReport &report)
+    {
+        Renderer& renderer = Renderer::Instance();
+        SDL_Renderer* sdlRenderer = renderer.GetSDLRenderer();
+
+        // Constant density world: collisions and culling scale like a real level
+        Scene world;
+        for (GameObject* npc : SpawnNPCs(count, 0.0f, BenchAnimation(), sdlRenderer))
+            world.AddObject(npc);
+        report.Add("scene_update", count, Sample(frames, [&]() { world.Update(BENCH_DT); }));
+        report.Add("scene_update_anim", count, Sample(frames, [&]() { world.UpdateAnim(BENCH_DT); }));
+        report.Add("scene_render_world", count, Sample(frames, [&]()
+        {
+            renderer.Clean();
+            world.Render(renderer);
+            renderer.Present();
+        }));
+
+        // Everything on screen: measures the draw path itself
+        Scene crowd;
+        for (GameObject* npc : SpawnNPCs(count, static_cast<float>(WINDOW_HEIGHT), BenchAnimation(), sdlRenderer))
+            crowd.AddObject(npc);
+        report.Add("scene_render_onscreen", count, Sample(frames, [&]()
+        {
+            renderer.Clean();
+            crowd.Render(renderer);
+            renderer.Present();
+        }));
+    }
+
+    void RunAnimationCase(int count, int frames, BenchReport &report)
+    {
+        Scene world;
+        for (GameObject* npc : SpawnNPCs(count, 0.0f, BenchAnimation()))
+            world.AddObject(npc);
+        size_t events = 0;
+        report.Add("scene_update_anim_100k", count, Sample(frames, [&]()
+        {
+            world.UpdateAnim(BENCH_DT);
+            events += world.GetAnimationEvents().size();
+        }));
+        std::cout << "  frame-change events per update: " << events / frames << std::endl;
+    }
+
+    void RunStaticLayerCase(int count, int frames, BenchReport &report)
+    {
+        Renderer& renderer = Renderer::Instance();
+        SDL_Renderer* sdlRenderer = renderer.GetSDLRenderer();
+        const float worldSize = 2.0f * WINDOW_WIDTH; // Several screens, so some chunks are off screen
+
+        // Baseline: the scenery as objects that never move, drawn sprite by sprite
+        Scene objects;
+        std::vector<GameObject*> props = SpawnNPCs(count, worldSize, BenchAnimation(), sdlRenderer);
+        for (GameObject* prop : props)
+            objects.AddObject(prop);
+        report.Add("static_objects_render", count, Sample(frames, [&]()
+        {
+            renderer.Clean();
+            objects.Render(renderer);
+            renderer.Present();
+        }));
+
+        // The same sprites in a static layer
+        Scene scenery;
+        StaticLayer& layer = scenery.GetStaticLayer(0);
+        TextureHandle texture = TextureManager::Instance().LoadTexture(BENCH_TEXTURES[0], sdlRenderer);
+        std::vector<StaticSpriteId> ids;
+        for (GameObject* prop : props)
+            ids.push_back(layer.Add(texture, prop->GetDestRect()));
+        auto draw = [&]()
+        {
+            renderer.Clean();
+            scenery.Render(renderer);
+            renderer.Present();
+        };
+        for (int i = 0; i < 4; ++i)
+            draw(); // Bake the visible chunks, a few per frame
+        report.Add("static_layer_render", count, Sample(frames, draw));
+        StaticLayerStats stats = layer.GetStats();
+        std::cout << "  static layer: " << stats.drawnChunks << " chunks blitted, "
+                  << stats.directSprites << " sprites drawn directly per frame" << std::endl;
+
+        // One sprite moves every frame: only the chunks it leaves and enters are drawn again
+        size_t next = 0;
+        Uint64 bakesBefore = layer.GetStats().bakes;
+        report.Add("static_layer_render_edit", count, Sample(frames, [&]()
+        {
+            SDL_FRect rect = props[next]->GetDestRect();
+            rect.x += 1.0f;
+            layer.Move(ids[next], rect);
+            next = (next + 1) % ids.size();
+            draw();
+        }));
+        std::cout << "  chunks redrawn per edited frame: " << static_cast<double>(layer.GetStats().bakes - bakesBefore) / frames << std::endl;
+    }
+}
+
+void RunSceneBenchmarks(const BenchOptions &options, BenchReport &report)
+{
+    std::cout << "Scene update, animation and render" << std::endl;
+    if (!InitOffscreenRenderer(WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        std::cout << "  skipped: could not create offscreen renderer: " << SDL_GetError() << std::endl;
+        return;
+    }
+    RunSceneCase(1000, options.quick ? 30 : 120, report);
+    RunSceneCase(10000, options.quick ? 10 : 60, report);
+    if (!options.quick)
+        RunSceneCase(100000, 20, report);
+    RunAnimationCase(100000, options.quick ? 30 : 120, report);
+    RunStaticLayerCase(20000, options.quick ? 30 : 120, report);
+}
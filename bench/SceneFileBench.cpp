@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+#include "AnimationLibrary.hpp"
+#include "Bench.hpp"
+#include "NPC.hpp"
+#include "Player.hpp"
+#include "Scene.hpp"
+#include "SceneFile.hpp"
+
+/**
+ * Scene loading benchmark.
+ *
+ * Builds a scene of 100k NPCs three ways: from a table of definitions whose type and animation
+ * are strings, matched per object (the way TestScene was built), from a scene file in text form,
+ * and from the same scene file compiled. Each sample builds a fresh scene; tearing it down is
+ * not timed.
+ */
+
+namespace
+{
+    constexpr int SCENE_FILE_OBJECTS = 100000;
+
+    /// @brief The previous per-object definition, kept as the baseline.
+    struct ObjectDef
+    {
+        std::string type;
+        float x, y;
+        float width, height;
+        std::string animation;
+        float speed;
+    };
+
+    std::vector<ObjectDef> MakeDefs(int count)
+    {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> position(0.0f, BENCH_SPACING * 300.0f);
+        std::vector<ObjectDef> defs;
+        defs.reserve(count);
+        defs.push_back({ "Player", 0.0f, 0.0f, 44.0f, 66.0f, "Bench", 0.0f });
+        for (int i = 1; i < count; ++i)
+            defs.push_back({ "NPC", position(rng), position(rng), 44.0f, 66.0f, "Bench", BENCH_NPC_SPEED });
+        return defs;
+    }
+}
+
+void RunSceneFileBenchmarks(const BenchOptions &options, BenchReport &report)
+{
+    std::cout << "Scene loading, per-object string definitions vs. scene file" << std::endl;
+    int frames = options.quick ? 3 : 10;
+    const std::vector<ObjectDef> defs = MakeDefs(SCENE_FILE_OBJECTS);
+    const std::unordered_map<std::string, AnimationSetDef> animations = { { "Bench", BENCH_ANIMATION } };
+    std::vector<std::unique_ptr<Scene>> scenes; // Kept until the case ends so teardown is not timed
+
+    report.Add("scene_build_defs", SCENE_FILE_OBJECTS, Sample(frames, [&]()
+    {
+        scenes.push_back(std::make_unique<Scene>());
+        Scene &scene = *scenes.back();
+        AnimationLibrary &library = AnimationLibrary::Instance();
+        for (const ObjectDef &def : defs)
+        {
+            AnimationSetRef animation = library.Load(def.animation, animations.at(def.animation));
+            if (def.type == "Player")
+                scene.Spawn<Player>(def.x, def.y, def.width, def.height, animation);
+            else if (def.type == "NPC")
+                scene.Spawn<NPC>(def.x, def.y, def.width, def.height, animation, def.speed);
+        }
+    }));
+    scenes.clear();
+
+    // The same scene as text, with its clips spelled out
+    std::ostringstream text;
+    for (const auto &[state, clip] : BENCH_ANIMATION)
+    {
+        static const char *const stateNames[] = { "idle_left", "idle_right", "walk_left", "walk_right" };
+        text << "anim Bench " << stateNames[static_cast<size_t>(state)] << ' ' << clip.frameRate;
+        for (const std::string &frame : clip.frames)
+            text << ' ' << frame;
+        text << '\n';
+    }
+    for (const ObjectDef &def : defs)
+    {
+        SceneObjectType type = def.type == "Player" ? SceneObjectType::Player : SceneObjectType::NPC;
+        text << "object " << SceneFile::GetTypeName(type) << ' ' << def.x << ' ' << def.y << ' ' << def.width << ' '
+             << def.height << ' ' << def.animation << ' ' << def.speed << '\n';
+    }
+    const std::string source = text.str();
+
+    size_t created = 0;
+    report.Add("scene_file_text", SCENE_FILE_OBJECTS, Sample(frames, [&]()
+    {
+        SceneFile file;
+        file.Parse(source, "bench.scene");
+        scenes.push_back(std::make_unique<Scene>());
+        file.Instantiate(*scenes.back());
+        created = scenes.back()->GetAllocationStats().pools.live;
+    }));
+    scenes.clear();
+
+    SceneFile compiled;
+    compiled.Parse(source, "bench.scene");
+    const std::string path = (std::filesystem::temp_directory_path() / "arrow2d_bench.scn").string();
+    if (!compiled.Save(path))
+        return;
+    report.Add("scene_file_compiled", SCENE_FILE_OBJECTS, Sample(frames, [&]()
+    {
+        SceneFile file;
+        file.Load(path);
+        scenes.push_back(std::make_unique<Scene>());
+        file.Instantiate(*scenes.back());
+        created = std::min(created, scenes.back()->GetAllocationStats().pools.live);
+    }));
+    scenes.clear();
+    std::filesystem::remove(path);
+    std::cout << "  objects created per load: " << created << " of " << SCENE_FILE_OBJECTS << std::endl;
+}
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include "Bench.hpp"
+#include "GameConfig.hpp"
+#include "Renderer.hpp"
+#include "SceneFile.hpp"
+#include "SceneManager.hpp"
+#include "TextureManager.hpp"
+
+/**
+ * Scene switching benchmark.
+ *
+ * Switches back and forth between two compiled scenes of SCENE_STACK_OBJECTS NPCs that share
+ * their sprites. scene_switch_blocking builds the next scene in one go and then destroys the
+ * previous one, the way a scene used to be created in Engine::Init; each sample is one switch,
+ * so it is the frame the game would freeze for. scene_switch_staged replaces the scene through
+ * a SceneManager and samples every frame of the switches, so its max is the worst frame. The
+ * texture loads the switches cause are printed after each case.
+ */
+
+namespace
+{
+    constexpr int SCENE_STACK_OBJECTS = 20000;
+
+    bool WriteScene(const std::string &path, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(0.0f, BENCH_SPACING * 150.0f);
+        SceneFile scene;
+        for (const auto &[state, clip] : BENCH_ANIMATION)
+            scene.AddClip("Bench", state, clip.frameRate, clip.frames);
+        for (int i = 0; i < SCENE_STACK_OBJECTS; ++i)
+            scene.AddObject(SceneObjectType::NPC, position(rng), position(rng), 44.0f, 66.0f, "Bench", BENCH_NPC_SPEED);
+        return scene.Save(path);
+    }
+}
+
+void RunSceneStackBenchmarks(const BenchOptions &options, BenchReport &report)
+{
+    std::cout << "Scene switching, blocking vs. built behind the current scene" << std::endl;
+    if (!InitOffscreenRenderer(WINDOW_WIDTH, WINDOW_HEIGHT))
+        return;
+    SDL_Renderer *sdlRenderer = Renderer::Instance().GetSDLRenderer();
+    TextureManager &textures = TextureManager::Instance();
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::string paths[2] = { (dir / "arrow2d_bench_a.scn").string(), (dir / "arrow2d_bench_b.scn").string() };
+    if (!WriteScene(paths[0], 1) || !WriteScene(paths[1], 2))
+        return;
+    int switches = options.quick ? 4 : 12;
+
+    std::unique_ptr<Scene> current = std::make_unique<Scene>();
+    size_t misses = textures.GetStats().misses;
+    int next = 0;
+    report.Add("scene_switch_blocking", SCENE_STACK_OBJECTS, Sample(switches, [&]()
+    {
+        SceneFile file;
+        file.Load(paths[next]);
+        std::unique_ptr<Scene> scene = std::make_unique<Scene>();
+        file.Instantiate(*scene);
+        textures.FinishLoading(sdlRenderer);
+        current = std::move(scene);
+        next ^= 1;
+    }));
+    current.reset();
+    std::cout << "  texture loads: " << textures.GetStats().misses - misses << std::endl;
+
+    SceneManager scenes;
+    scenes.Push(paths[next]);
+    scenes.FinishLoading();
+    misses = textures.GetStats().misses;
+    std::vector<double> frames;
+    for (int i = 0; i < switches; ++i)
+    {
+        next ^= 1;
+        scenes.Replace(paths[next]);
+        bool shown = false;
+        while (!shown)
+        {
+            std::vector<double> frame = Sample(1, [&]()
+            {
+                textures.ProcessUploads(sdlRenderer, TEXTURE_UPLOAD_BUDGET_BYTES);
+                shown = scenes.Advance();
+            });
+            frames.push_back(frame[0]);
+        }
+    }
+    report.Add("scene_switch_staged", SCENE_STACK_OBJECTS, frames);
+    std::cout << "  texture loads: " << textures.GetStats().misses - misses << ", frames per switch: "
+              << static_cast<double>(frames.size()) / switches << std::endl;
+    scenes.Clear();
+    std::filesystem::remove(paths[0]);
+    std::filesystem::remove(paths[1]);
+}
@@ -0,0 +1,88 @@
+#include <iostream>
+#include "Bench.hpp"
+#include "Renderer.hpp"
+#include "TextureManager.hpp"
+#include "GameConfig.hpp"
+
+/**
+ * TextureManager::LoadTexture benchmarks.
+ *
+ * "Cold" clears the texture manager before every sample, so each load reads and decodes the
+ * file and uploads it to the atlas. "Warm" repeats the load of an already cached path, which
+ * should only cost a cache lookup. "Async request" times handing out handles for a set of
+ * uncached files, which is all a scene's constructor waits for; "async finish" times the
+ * background decode and upload of that set. With --archive, "cold archive" repeats the cold
+ * load with the packed archive mounted, where the pixels come pre-decoded from the mapping.
+ */
+
+namespace
+{
+    constexpr int WARM_LOOKUPS = 1000; // Lookups per warm sample, so each sample is measurable
+}
+
+void RunTextureBenchmarks(const BenchOptions &options, BenchReport &report)
+{
+    std::cout << "TextureManager::LoadTexture" << std::endl;
+    if (!InitOffscreenRenderer(WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        std::cout << "  skipped: could not create offscreen renderer: " << SDL_GetError() << std::endl;
+        return;
+    }
+    SDL_Renderer* sdlRenderer = Renderer::Instance().GetSDLRenderer();
+    TextureManager& textures = TextureManager::Instance();
+    const std::string path = BENCH_TEXTURES[0];
+    int iterations = options.quick ? 20 : 100;
+
+    report.Add("texture_load_cold", 1, Sample(iterations, [&]()
+    {
+        textures.Clean();
+        textures.LoadTexture(path, sdlRenderer);
+    }));
+    report.Add("texture_load_warm_x1000", 1, Sample(iterations, [&]()
+    {
+        for (int i = 0; i < WARM_LOOKUPS; ++i)
+            textures.LoadTexture(path, sdlRenderer);
+    }));
+
+    int count = static_cast<int>(BENCH_TEXTURES.size());
+    std::vector<double> requestMs, finishMs;
+    for (int i = 0; i < iterations; ++i)
+    {
+        textures.Clean();
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (const std::string& file : BENCH_TEXTURES)
+            textures.LoadTextureAsync(file);
+        Uint64 requested = SDL_GetPerformanceCounter();
+        textures.FinishLoading(sdlRenderer);
+        Uint64 end = SDL_GetPerformanceCounter();
+        double freq = static_cast<double>(SDL_GetPerformanceFrequency());
+        requestMs.push_back((requested - start) * 1000.0 / freq);
+        finishMs.push_back((end - requested) * 1000.0 / freq);
+    }
+    report.Add("texture_async_request", count, requestMs);
+    report.Add("texture_async_finish", count, finishMs);
+
+    // Budget of a single image: with no handles held, every new load evicts the previous one
+    textures.Clean();
+    textures.SetBudget(1);
+    for (const std::string& file : BENCH_TEXTURES)
+        textures.LoadTexture(file, sdlRenderer);
+    TextureStats stats = textures.GetStats();
+    std::cout << "  budget check: " << stats.textures << " resident (" << stats.residentBytes << " bytes, " << stats.gpuBytes << " GPU bytes), "
+              << stats.evictions << " evictions, " << stats.hits << " hits, " << stats.misses << " misses" << std::endl;
+    textures.SetBudget(TEXTURE_MEMORY_BUDGET_BYTES);
+
+    if (options.archivePath.empty())
+        return;
+    textures.Clean();
+    if (!textures.MountArchive(options.archivePath) || !textures.GetArchive().Find(path))
+    {
+        std::cout << "  skipped archive: " << options.archivePath << " is missing or does not contain " << path << std::endl;
+        return;
+    }
+    report.Add("texture_load_cold_archive", 1, Sample(iterations, [&]()
+    {
+        textures.Clean();
+        textures.LoadTexture(path, sdlRenderer);
+    }));
+}
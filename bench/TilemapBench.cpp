@@ -0,0 +1,146 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include "Bench.hpp"
+#include "GameConfig.hpp"
+#include "Renderer.hpp"
+#include "Scene.hpp"
+#include "TextureManager.hpp"
+
+/**
+ * Tilemap benchmark.
+ *
+ * Builds a map of about two million tiles with scattered walls, then times Scene::Update with
+ * movers colliding against it and Tilemap::Render through the offscreen software renderer,
+ * both with the visible chunks already cached and while scrolling so new chunks are drawn.
+ * After the movement runs it checks that no mover has ended up inside a wall.
+ */
+
+namespace
+{
+    constexpr int MAP_WIDTH = 2048;  // Tiles
+    constexpr int MAP_HEIGHT = 1024; // Tiles
+    constexpr int MAP_TILE_SIZE = 32;
+    constexpr const char *MAP_TILESET = "assets/sprites/Tiles/Tiles.bmp";
+    constexpr TileId FLOOR_TILE = 1;
+    constexpr TileId WALL_TILE = 2;
+
+    /// @brief Scene that exposes its objects so the benchmark can inspect them.
+    class BenchScene : public Scene
+    {
+        public:
+            const std::vector<GameObject*>& GetObjects() const { return entities.owner; }
+    };
+
+    /// @brief Fills a floor layer and scatters short wall segments over a walls layer.
+    void BuildMap(Tilemap &map, const std::string &tileset)
+    {
+        map.Create(MAP_WIDTH, MAP_HEIGHT, MAP_TILE_SIZE, 2, tileset);
+        map.SetSolid(WALL_TILE, true);
+        std::mt19937 rng(19);
+        std::uniform_int_distribution<int> length(2, 8);
+        for (int ty = 0; ty < MAP_HEIGHT; ++ty)
+        {
+            for (int tx = 0; tx < MAP_WIDTH; ++tx)
+            {
+                map.SetTile(0, tx, ty, FLOOR_TILE);
+                if (tx == 0 || ty == 0 || tx == MAP_WIDTH - 1 || ty == MAP_HEIGHT - 1)
+                    map.SetTile(1, tx, ty, WALL_TILE);
+            }
+        }
+        // About one wall tile in twenty, as horizontal and vertical runs
+        for (int wall = 0; wall < MAP_WIDTH * MAP_HEIGHT / 100; ++wall)
+        {
+            int tx = std::uniform_int_distribution<int>(0, MAP_WIDTH - 1)(rng);
+            int ty = std::uniform_int_distribution<int>(0, MAP_HEIGHT - 1)(rng);
+            bool vertical = rng() & 1;
+            for (int i = length(rng); i > 0; --i)
+                map.SetTile(1, vertical ? tx : tx + i, vertical ? ty + i : ty, WALL_TILE);
+        }
+    }
+
+    /// @brief Counts objects whose hitbox overlaps a solid tile.
+    int CountInsideWalls(const BenchScene &scene, const Tilemap &map)
+    {
+        int inside = 0;
+        for (const GameObject* obj : scene.GetObjects())
+        {
+            SDL_FRect box = obj->GetHitbox();
+            bool overlaps = false;
+            map.ForEachSolidTile(box, [&](const SDL_FRect &tile) { overlaps = overlaps || GameObject::Intersects(box, tile); });
+            inside += overlaps ? 1 : 0;
+        }
+        return inside;
+    }
+
+    void RunMoverBench(int count, int frames, BenchReport &report)
+    {
+        BenchScene scene;
+        Tilemap &map = scene.GetTilemap();
+        BuildMap(map, "");
+        for (GameObject* npc : SpawnNPCs(count))
+        {
+            // Clear the walls under each mover so every one starts in open space
+            SDL_FRect box = npc->GetHitbox();
+            map.ForEachSolidTile(box, [&](const SDL_FRect &tile)
+            {
+                map.SetTile(1, static_cast<int>(tile.x) / MAP_TILE_SIZE, static_cast<int>(tile.y) / MAP_TILE_SIZE, EMPTY_TILE);
+            });
+            scene.AddObject(npc);
+        }
+        report.Add("scene_update_tilemap", count, Sample(frames, [&]() { scene.Update(BENCH_DT); }));
+        std::cout << "  movers inside walls after " << frames << " steps: " << CountInsideWalls(scene, map) << std::endl;
+    }
+
+    void RunRenderBench(int frames, BenchReport &report)
+    {
+        Renderer& renderer = Renderer::Instance();
+        TextureManager& textures = TextureManager::Instance();
+        Tilemap map;
+        BuildMap(map, MAP_TILESET);
+        textures.FinishLoading(renderer.GetSDLRenderer());
+
+        SDL_FRect camera = { 4096.0f, 4096.0f, static_cast<float>(WINDOW_WIDTH), static_cast<float>(WINDOW_HEIGHT) };
+        auto draw = [&]()
+        {
+            renderer.Clean();
+            map.Render(renderer, camera);
+            renderer.Present();
+        };
+        draw(); // Bake the visible chunks once
+        report.Add("tilemap_render_cached", MAP_WIDTH * MAP_HEIGHT, Sample(frames, draw));
+        std::cout << "  chunks drawn per frame: " << map.GetStats().drawnChunks << std::endl;
+
+        // Scroll one chunk width every few frames, so some frames draw new chunks
+        Uint64 bakesBefore = map.GetStats().bakes;
+        report.Add("tilemap_render_scroll", MAP_WIDTH * MAP_HEIGHT, Sample(frames, [&]()
+        {
+            camera.x += TILEMAP_CHUNK_TILES * MAP_TILE_SIZE / 4.0f;
+            draw();
+        }));
+        TilemapStats stats = map.GetStats();
+        std::cout << "  chunks drawn into textures while scrolling: " << stats.bakes - bakesBefore
+                  << ", chunk textures cached: " << stats.cachedChunks << std::endl;
+    }
+}
+
+void RunTilemapBenchmarks(const BenchOptions &options, BenchReport &report)
+{
+    std::cout << "Tilemap collision and chunk rendering (" << MAP_WIDTH * MAP_HEIGHT << " tiles)" << std::endl;
+    {
+        Tilemap map;
+        report.Add("tilemap_build", MAP_WIDTH * MAP_HEIGHT, Sample(1, [&]() { BuildMap(map, ""); }));
+        TilemapStats stats = map.GetStats();
+        std::cout << "  " << stats.chunks << " chunks, " << stats.solidTiles << " solid tiles" << std::endl;
+    }
+    RunMoverBench(1000, options.quick ? 30 : 120, report);
+    if (!options.quick)
+        RunMoverBench(10000, 20, report);
+
+    if (!InitOffscreenRenderer(WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        std::cerr << "  skipped rendering: " << SDL_GetError() << std::endl;
+        return;
+    }
+    RunRenderBench(options.quick ? 30 : 120, report);
+}
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "Bench.hpp"
+#include "GameConfig.hpp"
+#include "Scene.hpp"
+#include "SceneFile.hpp"
+
+/**
+ * World streaming benchmark.
+ *
+ * Writes a world of WORLD_REGIONS x WORLD_REGIONS compiled region files, then times
+ * Scene::Update with the whole world created up front against a streamed scene whose camera
+ * flies across the world, loading regions ahead of it and removing them behind it. The
+ * streamed case includes the streaming itself; its region reads run synchronously so every
+ * run loads the same regions on the same frames.
+ */
+
+namespace
+{
+    constexpr int WORLD_REGIONS = 16;
+    constexpr float WORLD_REGION_SIZE = 1024.0f;
+    constexpr int WORLD_REGION_OBJECTS = 400;
+
+    /// @brief Writes the region files and returns the world, or an empty path on failure.
+    std::string WriteWorld(const std::filesystem::path &dir, std::vector<std::string> &regionPaths)
+    {
+        std::filesystem::create_directories(dir);
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> offset(0.0f, WORLD_REGION_SIZE - 66.0f);
+        std::string world = "regionsize " + std::to_string(static_cast<int>(WORLD_REGION_SIZE)) + "\n";
+        for (int ry = 0; ry < WORLD_REGIONS; ++ry)
+        {
+            for (int rx = 0; rx < WORLD_REGIONS; ++rx)
+            {
+                SceneFile region;
+                for (const auto &[state, clip] : BENCH_ANIMATION)
+                    region.AddClip("Bench", state, clip.frameRate, clip.frames);
+                for (int i = 0; i < WORLD_REGION_OBJECTS; ++i)
+                    region.AddObject(SceneObjectType::NPC, rx * WORLD_REGION_SIZE + offset(rng), ry * WORLD_REGION_SIZE + offset(rng), 44.0f, 66.0f, "Bench", BENCH_NPC_SPEED);
+                std::string path = (dir / ("Region_" + std::to_string(rx) + "_" + std::to_string(ry) + ".scn")).string();
+                if (!region.Save(path))
+                    return {};
+                regionPaths.push_back(path);
+                world += "region " + std::to_string(rx) + " " + std::to_string(ry) + " " + path + "\n";
+            }
+        }
+        std::string worldPath = (dir / "World.world").string();
+        std::ofstream(worldPath) << world;
+        return worldPath;
+    }
+}
+
+void RunWorldBenchmarks(const BenchOptions &options, BenchReport &report)
+{
+    std::cout << "World streaming, whole world vs. regions around the camera" << std::endl;
+    const int total = WORLD_REGIONS * WORLD_REGIONS * WORLD_REGION_OBJECTS;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "arrow2d_bench_world";
+    std::vector<std::string> regionPaths;
+    std::string worldPath = WriteWorld(dir, regionPaths);
+    if (worldPath.empty())
+        return;
+    int frames = options.quick ? 60 : 240;
+
+    {
+        Scene whole;
+        for (const std::string &path : regionPaths)
+        {
+            SceneFile region;
+            if (region.Load(path))
+                region.Instantiate(whole);
+        }
+        report.Add("world_whole_update", total, Sample(frames, [&]() { whole.Update(BENCH_DT); }));
+    }
+
+    Scene streamed;
+    streamed.LoadWorld(worldPath);
+    streamed.GetWorld().SetSynchronous(true);
+    const float worldSize = WORLD_REGIONS * WORLD_REGION_SIZE;
+    SDL_FRect camera = { 0.0f, worldSize / 2.0f, static_cast<float>(WINDOW_WIDTH), static_cast<float>(WINDOW_HEIGHT) };
+    const float step = (worldSize - camera.w) / frames; // Fly across the whole world during the run
+    size_t peak = 0;
+    report.Add("world_streamed_update", total, Sample(frames, [&]()
+    {
+        streamed.GetWorld().Stream(streamed, camera);
+        streamed.Update(BENCH_DT);
+        camera.x += step;
+        peak = std::max(peak, streamed.GetWorld().GetStats().objects);
+    }));
+    std::cout << "  objects resident at peak: " << peak << " of " << total << std::endl;
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,55 @@
+#include <iostream>
+#include <string>
+#include "Bench.hpp"
+#include "GameConfig.hpp"
+#include "JobSystem.hpp"
+
+/**
+ * Arrow2D benchmark suite.
+ *
+ * Usage: Arrow2D_bench [--quick] [--json <path>] [--archive <assets.pak>]
+ * Run from the repository root so the sprite assets can be found.
+ */
+int main(int argc, char *argv[])
+{
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--quick")
+            options.quick = true;
+        else if (arg == "--json" && i + 1 < argc)
+            options.jsonPath = argv[++i];
+        else if (arg == "--archive" && i + 1 < argc)
+            options.archivePath = argv[++i];
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--quick] [--json <path>] [--archive <assets.pak>]" << std::endl;
+            return 1;
+        }
+    }
+
+    JobSystem::Instance().Init(JOB_WORKER_THREADS);
+    std::cout << "Job system workers: " << JobSystem::Instance().GetWorkerCount() << std::endl;
+
+    BenchReport report;
+    RunCollisionBenchmarks(options, report);
+    RunEntityStoreBenchmarks(options, report);
+    RunSceneBenchmarks(options, report);
+    RunTilemapBenchmarks(options, report);
+    RunTextureBenchmarks(options, report);
+    RunPoolBenchmarks(options, report);
+    RunInputBenchmarks(options, report);
+    RunSceneFileBenchmarks(options, report);
+    RunWorldBenchmarks(options, report);
+    RunSceneStackBenchmarks(options, report);
+
+    JobSystem::Instance().Shutdown();
+    if (!report.WriteJson(options.jsonPath))
+    {
+        std::cerr << "Failed to write " << options.jsonPath << std::endl;
+        return 1;
+    }
+    std::cout << "Results written to " << options.jsonPath << std::endl;
+    return 0;
+}
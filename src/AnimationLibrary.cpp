@@ -0,0 +1,30 @@
+#include "AnimationLibrary.hpp"
+
+AnimationLibrary& AnimationLibrary::Instance()
+{
+    static AnimationLibrary instance;
+    return instance;
+}
+
+AnimationSetRef AnimationLibrary::Load(const std::string &name, const AnimationSetDef &def)
+{
+    std::weak_ptr<const AnimationSet> &entry = sets[name];
+    AnimationSetRef set = entry.lock();
+    if (!set)
+    {
+        set = std::make_shared<const AnimationSet>(def);
+        entry = set;
+    }
+    return set;
+}
+
+AnimationSetRef AnimationLibrary::Find(const std::string &name) const
+{
+    auto it = sets.find(name);
+    return it != sets.end() ? it->second.lock() : nullptr;
+}
+
+void AnimationLibrary::Clean()
+{
+    sets.clear();
+}
@@ -0,0 +1,56 @@
+#ifndef ANIMATIONLIBRARY_HPP
+#define ANIMATIONLIBRARY_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "AnimationSet.hpp"
+
+/**
+ * @class AnimationLibrary
+ * @brief Hands out shared, read-only AnimationSets by name.
+ *
+ * Objects of the same kind all reference one set, so a thousand NPCs cost one set of frame
+ * arrays and texture handles rather than a thousand. The library only keeps weak references:
+ * a set is destroyed with its last user, releasing its textures to the TextureManager's
+ * eviction, and a later Load() of the same name builds it again.
+ *
+ * Usage:
+ *   - Call Load() with a name and definition when building a scene; later calls with the same
+ *     name return the existing set while anything still uses it.
+ *   - Keep the returned AnimationSetRef for as long as the set is drawn.
+ */
+class AnimationLibrary
+{
+    public:
+        /**
+         * @brief Provides access to the singleton instance of the AnimationLibrary.
+         */
+        static AnimationLibrary& Instance();
+
+        /**
+         * @brief Gets the set with the given name, building it from @p def the first time.
+         * @param name Unique name of the set, e.g. the kind of object using it.
+         * @param def Clip definitions, ignored if the set already exists.
+         * @return The shared set.
+         */
+        AnimationSetRef Load(const std::string &name, const AnimationSetDef &def);
+
+        /**
+         * @brief Gets a previously loaded set.
+         * @return The set, or nullptr if none with that name is in use.
+         */
+        AnimationSetRef Find(const std::string &name) const;
+
+        /**
+         * @brief Forgets every set. Sets still in use live on until their last user drops them.
+         */
+        void Clean();
+
+    private:
+        AnimationLibrary() = default;
+
+        std::unordered_map<std::string, std::weak_ptr<const AnimationSet>> sets;
+};
+
+#endif // ANIMATIONLIBRARY_HPP
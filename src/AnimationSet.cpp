@@ -0,0 +1,65 @@
+#include "AnimationSet.hpp"
+#include "TextureManager.hpp"
+#include <limits>
+
+namespace
+{
+    const TextureHandle NO_TEXTURE;
+
+    /// @brief Clip to borrow when a state has none: walk -> idle on the same side, then the other side.
+    constexpr AnimState FALLBACKS[ANIM_STATE_COUNT][3] =
+    {
+        /* IdleLeft */  { AnimState::IdleRight, AnimState::WalkLeft, AnimState::WalkRight },
+        /* IdleRight */ { AnimState::IdleLeft, AnimState::WalkRight, AnimState::WalkLeft },
+        /* WalkLeft */  { AnimState::IdleLeft, AnimState::WalkRight, AnimState::IdleRight },
+        /* WalkRight */ { AnimState::IdleRight, AnimState::WalkLeft, AnimState::IdleLeft },
+    };
+}
+
+AnimationSet::AnimationSet(const AnimationSetDef &def)
+{
+    TextureManager &textures = TextureManager::Instance();
+    for (const auto &[state, clipDef] : def)
+    {
+        AnimationClip &clip = clips[static_cast<size_t>(state)];
+        float rateDuration = clipDef.frameRate > 0.0f ? 1.0f / clipDef.frameRate : std::numeric_limits<float>::infinity();
+        for (size_t frame = 0; frame < clipDef.frames.size(); ++frame)
+        {
+            float duration = frame < clipDef.durations.size() && clipDef.durations[frame] > 0.0f ? clipDef.durations[frame] : rateDuration;
+            clip.frames.push_back({ textures.LoadTextureAsync(clipDef.frames[frame]), duration });
+        }
+    }
+
+    // Only borrow from clips that were defined, so the result doesn't depend on state order.
+    const std::array<AnimationClip, ANIM_STATE_COUNT> defined = clips;
+    for (size_t state = 0; state < ANIM_STATE_COUNT; ++state)
+    {
+        if (!clips[state].frames.empty())
+            continue;
+        for (AnimState fallback : FALLBACKS[state])
+        {
+            const AnimationClip &other = defined[static_cast<size_t>(fallback)];
+            if (!other.frames.empty())
+            {
+                clips[state] = other;
+                break;
+            }
+        }
+    }
+}
+
+const TextureHandle &AnimationSet::GetFrameTexture(AnimState state, Uint16 frame) const
+{
+    const std::vector<AnimationFrame> &frames = clips[static_cast<size_t>(state)].frames;
+    if (frames.empty())
+        return NO_TEXTURE;
+    return frames[frame < frames.size() ? frame : 0].texture;
+}
+
+float AnimationSet::GetFrameDuration(AnimState state, Uint16 frame) const
+{
+    const std::vector<AnimationFrame> &frames = clips[static_cast<size_t>(state)].frames;
+    if (frames.size() < 2)
+        return std::numeric_limits<float>::infinity();
+    return frames[frame < frames.size() ? frame : 0].duration;
+}
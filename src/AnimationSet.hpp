@@ -0,0 +1,107 @@
+#ifndef ANIMATIONSET_HPP
+#define ANIMATIONSET_HPP
+
+#include <SDL3/SDL.h>
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "TextureHandle.hpp"
+
+/**
+ * @enum AnimState
+ * @brief Represents animation states for any game object. Each state plays one AnimationClip.
+ */
+enum class AnimState : Uint8 { IdleLeft, IdleRight, WalkLeft, WalkRight };
+
+/// @brief Number of AnimState values, for arrays indexed by state.
+constexpr size_t ANIM_STATE_COUNT = 4;
+
+/**
+ * @brief Checks if a state faces right. Right-facing states have odd values and walking
+ * states are the idle ones plus 2, which AnimationSystem relies on to pick states without branches.
+ */
+inline bool IsFacingRight(AnimState state) { return state == AnimState::IdleRight || state == AnimState::WalkRight; }
+
+/**
+ * @struct AnimationFrame
+ * @brief One image of a clip and how long it is shown.
+ */
+struct AnimationFrame
+{
+    TextureHandle texture;
+    float duration; // Seconds, infinite for frames that never advance
+};
+
+/**
+ * @struct AnimationClip
+ * @brief The frames played, in order and looping, while an object is in one AnimState.
+ */
+struct AnimationClip
+{
+    std::vector<AnimationFrame> frames;
+};
+
+/**
+ * @struct AnimationClipDef
+ * @brief Source description of a clip: image paths, played at the clip's frame rate.
+ */
+struct AnimationClipDef
+{
+    std::vector<std::string> frames; // Image paths, in playback order
+    float frameRate = 10.0f;         // Frames per second; 0 holds the first frame
+    std::vector<float> durations;    // Optional per-frame seconds overriding frameRate, 0 keeps the rate
+};
+
+/// @brief Source description of a full set, one clip per state. States left out reuse another clip.
+using AnimationSetDef = std::unordered_map<AnimState, AnimationClipDef>;
+
+/**
+ * @class AnimationSet
+ * @brief Immutable, shared sprite animations for one kind of object.
+ *
+ * Holds one clip per AnimState as a plain array of frames, so the frame to draw is found by
+ * indexing with the state and a frame number rather than by hashing. Any number of objects
+ * can share one set (see AnimationLibrary); each object only keeps a reference to it plus its
+ * own state, frame number and frame timer.
+ *
+ * A state with no frames in the definition plays a related clip instead: walking falls back
+ * to idle on the same side, and one side falls back to the other.
+ */
+class AnimationSet
+{
+    public:
+        /**
+         * @brief Builds the set and starts loading its textures in the background.
+         * @param def Image paths and frame durations for each state.
+         */
+        explicit AnimationSet(const AnimationSetDef &def);
+
+        /**
+         * @brief Gets the clip played in a state. It may have no frames if the whole set is empty.
+         */
+        const AnimationClip &GetClip(AnimState state) const { return clips[static_cast<size_t>(state)]; }
+
+        /**
+         * @brief Gets the texture of one frame of a state's clip.
+         * @param state The animation state.
+         * @param frame Frame number; out-of-range numbers give the first frame.
+         * @return The frame's texture, or an empty handle if the clip has no frames.
+         */
+        const TextureHandle &GetFrameTexture(AnimState state, Uint16 frame) const;
+
+        /**
+         * @brief Gets how long one frame of a state's clip is shown.
+         * @return Seconds, or infinity if the clip has fewer than two frames and so never advances.
+         */
+        float GetFrameDuration(AnimState state, Uint16 frame) const;
+
+    private:
+        std::array<AnimationClip, ANIM_STATE_COUNT> clips;
+};
+
+/// @brief Shared ownership of a set. The set, and the texture handles it holds, go away with its last reference.
+using AnimationSetRef = std::shared_ptr<const AnimationSet>;
+
+#endif // ANIMATIONSET_HPP
@@ -0,0 +1,85 @@
+#include "AnimationSystem.hpp"
+#include "EntityStore.hpp"
+#include "Profiler.hpp"
+#include <limits>
+
+namespace
+{
+    /**
+     * Pass 1 of AnimationSystem::Update(), kept in its own function so the arrays can be marked
+     * __restrict: without it the byte arrays may alias the float ones and the loop is not
+     * vectorized. Everything is computed in ints so every lane has the same shape. States are
+     * laid out so that bit 0 is "facing right" and bit 1 is "walking" (see AnimState).
+     */
+    void SelectAndTick(size_t count, float dt, const float *__restrict vx, const float *__restrict vy,
+                       const Uint8 *__restrict state, float *__restrict timer, const float *__restrict duration,
+                       Uint8 *__restrict next, Uint8 *__restrict changed)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            int current = state[i];
+            int still = vx[i] == 0.0f ? 1 : 0;
+            int right = (vx[i] > 0.0f ? 1 : 0) | (still & current);
+            int walking = (still ^ 1) | (vy[i] != 0.0f ? 1 : 0);
+            int chosen = right | (walking << 1);
+            float t = timer[i] + dt;
+            timer[i] = t;
+            next[i] = static_cast<Uint8>(chosen);
+            changed[i] = static_cast<Uint8>((chosen != current ? 1 : 0) | (t >= duration[i] ? 1 : 0));
+        }
+    }
+}
+
+void AnimationSystem::Update(EntityStore &store, float dt)
+{
+    PROFILE_ZONE("AnimationSystem::Update");
+    static_assert(sizeof(AnimState) == 1, "AnimationSystem reads AnimState as bytes");
+    const size_t count = store.Size();
+    nextState.resize(count);
+    changed.resize(count);
+    events.clear();
+
+    SelectAndTick(count, dt, store.vx.data(), store.vy.data(), reinterpret_cast<const Uint8 *>(store.animState.data()),
+                  store.animTimer.data(), store.animDuration.data(), nextState.data(), changed.data());
+
+    // Pass 2: only entities whose displayed frame changes
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!changed[i])
+            continue;
+        const AnimationSet *animation = store.animation[i];
+        AnimState state = static_cast<AnimState>(nextState[i]);
+        Uint16 frame = store.animFrame[i];
+        float timer = store.animTimer[i];
+        float duration = store.animDuration[i];
+        if (state != store.animState[i])
+        {
+            // New clip: start it from its first frame
+            store.animState[i] = state;
+            frame = 0;
+            timer = 0.0f;
+            duration = animation ? animation->GetFrameDuration(state, 0) : std::numeric_limits<float>::infinity();
+        }
+        else
+        {
+            // Step past every frame whose time ran out; a long dt may skip several
+            Uint16 start = frame;
+            while (timer >= duration)
+            {
+                timer -= duration;
+                size_t frames = animation->GetClip(state).frames.size();
+                frame = static_cast<Uint16>((frame + 1) % frames);
+                duration = animation->GetFrameDuration(state, frame);
+            }
+            if (frame == start)
+            {
+                store.animTimer[i] = timer;
+                continue;
+            }
+        }
+        store.animFrame[i] = frame;
+        store.animTimer[i] = timer;
+        store.animDuration[i] = duration;
+        events.push_back({ store.ids[i], state, frame });
+    }
+}
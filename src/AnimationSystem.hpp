@@ -0,0 +1,55 @@
+#ifndef ANIMATIONSYSTEM_HPP
+#define ANIMATIONSYSTEM_HPP
+
+#include <SDL3/SDL.h>
+#include <vector>
+#include "AnimationSet.hpp"
+#include "GameObject.hpp"
+
+class EntityStore;
+
+/**
+ * @struct AnimationEvent
+ * @brief Reports that an entity's displayed frame changed during the last AnimationSystem update.
+ */
+struct AnimationEvent
+{
+    EntityId entity;
+    AnimState state; // State after the change
+    Uint16 frame;    // Frame after the change
+};
+
+/**
+ * @class AnimationSystem
+ * @brief Advances the animation of every entity in an EntityStore in a few tight passes.
+ *
+ * The first pass runs over all entities at once and only touches contiguous arrays: it picks
+ * each entity's state from its velocity (walking when moving, facing its horizontal direction
+ * or keeping its old facing when not moving sideways), adds the time step to its frame timer and
+ * flags the entities whose state changed or whose frame ran out. It has no calls and no
+ * branches, so the compiler can vectorize it. Only flagged entities, normally a small fraction,
+ * then visit their AnimationSet to move to the next frame, and each one emits an
+ * AnimationEvent. Entities whose frame did not change produce no work beyond the first pass.
+ */
+class AnimationSystem
+{
+    public:
+        /**
+         * @brief Advances all animations in @p store by @p dt and records the frame changes.
+         * @param store The entities to animate.
+         * @param dt Time elapsed since the last update (in seconds).
+         */
+        void Update(EntityStore &store, float dt);
+
+        /**
+         * @brief Gets the frame changes from the most recent Update(), in storage order.
+         */
+        const std::vector<AnimationEvent> &GetEvents() const { return events; }
+
+    private:
+        std::vector<Uint8> nextState; // Scratch: state chosen by the first pass
+        std::vector<Uint8> changed;   // Scratch: 1 where the state or frame must change
+        std::vector<AnimationEvent> events;
+};
+
+#endif // ANIMATIONSYSTEM_HPP
@@ -0,0 +1,63 @@
+#include "Arena.hpp"
+#include <cstdint>
+
+Arena::Arena(size_t blockSize)
+    : blockSize(blockSize)
+{
+}
+
+Arena::~Arena()
+{
+    RunFinalizers();
+}
+
+void *Arena::Allocate(size_t size, size_t align)
+{
+    // Align the absolute address, since blocks are only aligned for max_align_t
+    if (!blocks.empty())
+    {
+        Block &block = blocks.back();
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.memory.get());
+        size_t offset = ((base + used + align - 1) & ~(static_cast<uintptr_t>(align) - 1)) - base;
+        if (offset + size <= block.size)
+        {
+            stats.bytesUsed += offset + size - used;
+            ++stats.allocations;
+            used = offset + size;
+            return block.memory.get() + offset;
+        }
+    }
+
+    // Start a new block, big enough for this allocation at any alignment
+    size_t sizeNeeded = size + align;
+    size_t newSize = sizeNeeded > blockSize ? sizeNeeded : blockSize;
+    blocks.push_back({ std::make_unique<unsigned char[]>(newSize), newSize });
+    ++stats.blocks;
+    stats.bytesReserved += newSize;
+    used = 0;
+    return Allocate(size, align);
+}
+
+void Arena::Reset()
+{
+    RunFinalizers();
+    if (blocks.size() > 1)
+        blocks.erase(blocks.begin() + 1, blocks.end());
+    used = 0;
+    stats = {};
+    if (!blocks.empty())
+    {
+        stats.blocks = 1;
+        stats.bytesReserved = blocks[0].size;
+    }
+}
+
+void Arena::RunFinalizers()
+{
+    while (finalizers)
+    {
+        Finalizer *finalizer = finalizers;
+        finalizers = finalizer->next;
+        finalizer->destroy(finalizer->object);
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct ArenaStats
+ * @brief Arena memory use and allocation counters.
+ */
+struct ArenaStats
+{
+    size_t blocks = 0;        // Blocks held, each one global allocation
+    size_t bytesReserved = 0; // Total size of those blocks
+    size_t bytesUsed = 0;     // Bytes handed out since the last Reset(), including alignment padding
+    Uint64 allocations = 0;   // Allocate() calls served since the last Reset()
+};
+
+/**
+ * @class Arena
+ * @brief Bump allocator for data that lives exactly as long as its owner, such as a scene.
+ *
+ * Memory is carved out of large blocks by moving a pointer forward, so an allocation costs a
+ * few instructions and never calls the global allocator except to start a new block.
+ * Individual allocations are never freed; everything is released at once by Reset() or the
+ * destructor. Objects created with New() have their destructors run then, in reverse order
+ * of creation.
+ *
+ * Not thread-safe: allocate from one thread at a time.
+ */
+class Arena
+{
+    public:
+        /**
+         * @brief Constructs an empty arena. No memory is reserved until the first allocation.
+         * @param blockSize Size of each block; larger allocations get a block of their own.
+         */
+        explicit Arena(size_t blockSize);
+
+        /**
+         * @brief Runs pending destructors and frees every block.
+         */
+        ~Arena();
+
+        /**
+         * @brief Allocates uninitialized memory that stays valid until Reset() or destruction.
+         * @param size Number of bytes.
+         * @param align Alignment, a power of two.
+         */
+        void *Allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+        /**
+         * @brief Constructs an object in the arena.
+         *
+         * Its destructor, if not trivial, runs when the arena is reset or destroyed.
+         *
+         * @return The new object, owned by the arena.
+         */
+        template <typename T, typename... Args>
+        T *New(Args&&... args)
+        {
+            T *object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                Finalizer *finalizer = new (Allocate(sizeof(Finalizer), alignof(Finalizer))) Finalizer;
+                finalizer->destroy = [](void *p) { static_cast<T *>(p)->~T(); };
+                finalizer->object = object;
+                finalizer->next = finalizers;
+                finalizers = finalizer;
+            }
+            return object;
+        }
+
+        /**
+         * @brief Runs pending destructors and makes all memory available again.
+         *
+         * The first block is kept for reuse; the others are freed.
+         */
+        void Reset();
+
+        /**
+         * @brief Gets the memory use and allocation counters.
+         */
+        const ArenaStats &GetStats() const { return stats; }
+
+    private:
+        /// @brief Destructor to run for an object made by New(); stored in the arena itself.
+        struct Finalizer
+        {
+            void (*destroy)(void *);
+            void *object;
+            Finalizer *next;
+        };
+
+        struct Block
+        {
+            std::unique_ptr<unsigned char[]> memory;
+            size_t size;
+        };
+
+        /// @brief Runs and forgets every finalizer, newest first.
+        void RunFinalizers();
+
+        std::vector<Block> blocks;
+        size_t blockSize;
+        size_t used = 0; // Bytes used in the last block
+        Finalizer *finalizers = nullptr;
+        ArenaStats stats;
+};
+
+#endif // ARENA_HPP
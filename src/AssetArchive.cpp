@@ -0,0 +1,145 @@
+#include "AssetArchive.hpp"
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetArchive::~AssetArchive()
+{
+    Close();
+}
+
+bool AssetArchive::Open(const std::string &path)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER fileSize;
+    HANDLE mappingHandle = nullptr;
+    if (GetFileSizeEx(fileHandle, &fileSize) && fileSize.QuadPart > 0)
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void *view = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view)
+    {
+        if (mappingHandle)
+            CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        return false;
+    }
+    file = fileHandle;
+    mapping = mappingHandle;
+    data = static_cast<const Uint8 *>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    void *view = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+        view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file alive
+    if (view == MAP_FAILED)
+        return false;
+    data = static_cast<const Uint8 *>(view);
+    size = static_cast<size_t>(info.st_size);
+#endif
+
+    // Validate the header and that the table lies inside the file before trusting either
+    header = reinterpret_cast<const ArchiveHeader *>(data);
+    bool valid = size >= sizeof(ArchiveHeader)
+        && std::memcmp(header->magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) == 0
+        && header->version == ARCHIVE_VERSION
+        && header->tableSlots > 0 && (header->tableSlots & (header->tableSlots - 1)) == 0
+        && header->tableOffset <= size
+        && (size - header->tableOffset) / sizeof(ArchiveEntry) >= header->tableSlots;
+    if (!valid)
+    {
+        SDL_Log("Not a valid asset archive: %s", path.c_str());
+        Close();
+        return false;
+    }
+    table = reinterpret_cast<const ArchiveEntry *>(data + header->tableOffset);
+    return true;
+}
+
+void AssetArchive::Close()
+{
+    if (data)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle(static_cast<HANDLE>(mapping));
+        CloseHandle(static_cast<HANDLE>(file));
+        file = nullptr;
+        mapping = nullptr;
+#else
+        munmap(const_cast<Uint8 *>(data), size);
+#endif
+    }
+    data = nullptr;
+    size = 0;
+    header = nullptr;
+    table = nullptr;
+}
+
+bool AssetArchive::IsOpen() const { return data != nullptr; }
+
+const ArchiveEntry *AssetArchive::Find(std::string_view path) const
+{
+    if (!table)
+        return nullptr;
+    Uint64 hash = HashPath(path);
+    Uint32 mask = header->tableSlots - 1;
+    // Linear probing; the packer keeps the table at most half full, so probes stay short
+    for (Uint32 i = static_cast<Uint32>(hash) & mask, n = 0; n <= mask; i = (i + 1) & mask, ++n)
+    {
+        const ArchiveEntry &entry = table[i];
+        if (entry.hash == hash)
+            return entry.offset + entry.size <= size ? &entry : nullptr;
+        if (entry.hash == 0)
+            return nullptr;
+    }
+    return nullptr;
+}
+
+const void *AssetArchive::GetData(const ArchiveEntry &entry) const
+{
+    return data + entry.offset;
+}
+
+SDL_Surface *AssetArchive::CreateSurface(const ArchiveEntry &entry) const
+{
+    if (entry.type != ArchiveEntryType::Image || static_cast<Uint64>(entry.pitch) * entry.height > entry.size)
+        return nullptr;
+    // SDL only reads the pixels of a surface it is given; the cast does not make them writable
+    return SDL_CreateSurfaceFrom(static_cast<int>(entry.width), static_cast<int>(entry.height), static_cast<SDL_PixelFormat>(entry.format),
+                                 const_cast<void *>(GetData(entry)), static_cast<int>(entry.pitch));
+}
+
+Uint32 AssetArchive::GetEntryCount() const
+{
+    return header ? header->entryCount : 0;
+}
+
+Uint64 AssetArchive::HashPath(std::string_view path)
+{
+    Uint64 hash = 14695981039346656037ull;
+    for (char c : path)
+    {
+        hash ^= static_cast<Uint8>(c == '\\' ? '/' : c);
+        hash *= 1099511628211ull;
+    }
+    return hash ? hash : 1;
+}
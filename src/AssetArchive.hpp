@@ -0,0 +1,148 @@
+#ifndef ASSETARCHIVE_HPP
+#define ASSETARCHIVE_HPP
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <string_view>
+
+/**
+ * Packed asset archive (.pak) format.
+ *
+ * An archive is written offline by the Arrow2D_pack tool and memory-mapped at runtime. It
+ * starts with an ArchiveHeader, followed by the payloads, followed by the table of contents:
+ * an open-addressing hash table of ArchiveEntry slots keyed by the 64-bit hash of each asset's
+ * path. Images are stored already decoded in the atlas pixel format (RGBA32), so loading one is
+ * a pointer into the mapping rather than a file read and decode. Other files (fonts) are stored
+ * as raw bytes. Payloads are aligned to ARCHIVE_ALIGNMENT bytes. All fields are little-endian.
+ */
+
+constexpr char ARCHIVE_MAGIC[8] = { 'A', '2', 'D', 'P', 'A', 'K', '\0', '\0' };
+constexpr Uint32 ARCHIVE_VERSION = 1;
+constexpr Uint64 ARCHIVE_ALIGNMENT = 64;
+
+/**
+ * @enum ArchiveEntryType
+ * @brief What an archive payload holds.
+ */
+enum class ArchiveEntryType : Uint32
+{
+    Raw = 0,   // The file's bytes, unchanged
+    Image = 1  // Decoded pixels in ArchiveEntry::format
+};
+
+/**
+ * @struct ArchiveHeader
+ * @brief First bytes of an archive file.
+ */
+struct ArchiveHeader
+{
+    char magic[8];      // ARCHIVE_MAGIC
+    Uint32 version;     // ARCHIVE_VERSION
+    Uint32 entryCount;  // Assets in the archive
+    Uint32 tableSlots;  // Slots in the table of contents, a power of two
+    Uint32 reserved;
+    Uint64 tableOffset; // Byte offset of the table of contents
+};
+
+/**
+ * @struct ArchiveEntry
+ * @brief One slot of the table of contents. A hash of 0 marks an empty slot.
+ */
+struct ArchiveEntry
+{
+    Uint64 hash;   // AssetArchive::HashPath() of the asset's path
+    Uint64 offset; // Byte offset of the payload
+    Uint64 size;   // Payload size in bytes
+    ArchiveEntryType type;
+    Uint32 format; // SDL_PixelFormat of an image payload
+    Uint32 width;  // Image width in pixels
+    Uint32 height; // Image height in pixels
+    Uint32 pitch;  // Bytes per image row
+    Uint32 reserved;
+};
+
+static_assert(sizeof(ArchiveHeader) == 32, "ArchiveHeader layout is part of the file format");
+static_assert(sizeof(ArchiveEntry) == 48, "ArchiveEntry layout is part of the file format");
+
+/**
+ * @class AssetArchive
+ * @brief Read-only view of a memory-mapped asset archive.
+ *
+ * Opening maps the whole file; nothing is read until a payload is touched, and payloads are
+ * used in place. Lookups hash the path and probe the table, so no strings are compared.
+ *
+ * Usage:
+ *   - Call Open() with the archive path; Close() (or destruction) unmaps it.
+ *   - Call Find() with an asset path, as it would be passed to SDL_LoadBMP().
+ *   - Use GetData() for raw payloads or CreateSurface() for images.
+ */
+class AssetArchive
+{
+    public:
+        AssetArchive() = default;
+        ~AssetArchive();
+        AssetArchive(const AssetArchive &) = delete;
+        AssetArchive &operator=(const AssetArchive &) = delete;
+
+        /**
+         * @brief Maps an archive file, replacing any archive already open.
+         * @param path Path of the .pak file.
+         * @return true if the file was mapped and has a valid header.
+         */
+        bool Open(const std::string &path);
+
+        /**
+         * @brief Unmaps the archive. Data and surfaces obtained from it become invalid.
+         */
+        void Close();
+
+        /**
+         * @brief Checks if an archive is mapped.
+         */
+        bool IsOpen() const;
+
+        /**
+         * @brief Looks up an asset by path.
+         * @param path Asset path; '\\' and '/' are treated as the same separator.
+         * @return The entry, or nullptr if the archive does not contain the asset.
+         */
+        const ArchiveEntry *Find(std::string_view path) const;
+
+        /**
+         * @brief Gets a pointer to an entry's payload inside the mapping.
+         */
+        const void *GetData(const ArchiveEntry &entry) const;
+
+        /**
+         * @brief Wraps an image entry's pixels in a surface without copying them.
+         *
+         * The surface points into the mapping, must not be written to, and must be destroyed
+         * before the archive is closed.
+         *
+         * @return The surface, or nullptr if the entry is not an image.
+         */
+        SDL_Surface *CreateSurface(const ArchiveEntry &entry) const;
+
+        /**
+         * @brief Gets the number of assets in the archive.
+         */
+        Uint32 GetEntryCount() const;
+
+        /**
+         * @brief Hashes an asset path (64-bit FNV-1a, separators normalized to '/').
+         * @return The hash; never 0, which marks empty table slots.
+         */
+        static Uint64 HashPath(std::string_view path);
+
+    private:
+        const Uint8 *data = nullptr;
+        size_t size = 0;
+        const ArchiveHeader *header = nullptr;
+        const ArchiveEntry *table = nullptr;
+#ifdef _WIN32
+        void *file = nullptr;    // HANDLE of the archive file
+        void *mapping = nullptr; // HANDLE of its file mapping
+#endif
+};
+
+#endif // ASSETARCHIVE_HPP
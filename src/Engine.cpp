@@ -1,10 +1,21 @@
 #include <iostream>
+#include "AnimationLibrary.hpp"
 #include "Renderer.hpp"
 #include "InputManager.hpp"
 #include "TextureManager.hpp"
 #include "Engine.hpp"
-#include "Scenes/TestScene.hpp"
 #include "GameConfig.hpp"
+#include "Profiler.hpp"
+#include "JobSystem.hpp"
+#include <cmath>
+
+namespace
+{
+    double ElapsedMs(Uint64 from, Uint64 to)
+    {
+        return (to - from) * 1000.0 / SDL_GetPerformanceFrequency();
+    }
+}
 
 Engine& Engine::Instance()
 {
@@ -12,17 +23,29 @@ Engine& Engine::Instance()
     return instance;
 }
 
-bool Engine::Init(const char* title, int width, int height)
+bool Engine::Init(const char* title, int width, int height, bool headless)
 {
     this->title = WINDOW_TITLE;
     this->width = WINDOW_WIDTH;
     this->height = WINDOW_HEIGHT;
+    this->headless = headless;
+
+    // Headless runs use an offscreen video driver so no display or GPU is needed
+    if (headless)
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, HEADLESS_VIDEO_DRIVERS);
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        std::cerr << "Failed to initialize SDL video: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    JobSystem::Instance().Init(JOB_WORKER_THREADS);
 
     // Use singleton subsystems
     renderer = &Renderer::Instance();
     inputManager = &InputManager::Instance();
     textureManager = &TextureManager::Instance();
-    SDL_Window* window = SDL_CreateWindow(WINDOW_TITLE, WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_FLAGS);
+    window = SDL_CreateWindow(WINDOW_TITLE, WINDOW_WIDTH, WINDOW_HEIGHT, headless ? SDL_WINDOW_HIDDEN : WINDOW_FLAGS);
     if (!inputManager)
     {
         std::cerr << "Failed to initialize input manager subsystem." << std::endl;
@@ -38,63 +61,253 @@ bool Engine::Init(const char* title, int width, int height)
         std::cerr << "Failed to create SDL_Window: " << SDL_GetError() << std::endl;
         return false;
     }
-    if (!renderer->Init(window))
+    if (!renderer->Init(window, headless ? SDL_SOFTWARE_RENDERER : NULL))
     {
         std::cerr << "Failed to initialize renderer." << std::endl;
         SDL_DestroyWindow(window);
+        window = nullptr;
         return false;
     }
+    renderer->SetBatching(RENDER_BATCH_SPRITES);
+    if (VSYNC_ENABLED && !headless)
+    {
+        int vsync = 0;
+        if (SDL_SetRenderVSync(renderer->GetSDLRenderer(), 1) && SDL_GetRenderVSync(renderer->GetSDLRenderer(), &vsync))
+            pacer.SetVSync(vsync != 0);
+        else
+            std::cerr << "VSync unavailable, using the frame pacer: " << SDL_GetError() << std::endl;
+    }
+
+#if ARROW2D_PROFILING
+    // The overlay is optional: without its font the game still runs, just without it
+    if (!headless && profilerOverlay.Init(PROFILER_FONT_PATH, PROFILER_FONT_SIZE) && PROFILER_OVERLAY_VISIBLE)
+        profilerOverlay.Toggle();
+#endif
 
-    // Create test scene
-    scene = new TestScene(*renderer, *textureManager, WINDOW_WIDTH, WINDOW_HEIGHT);
+    // Serve assets from the packed archive when one has been built
+    textureManager->MountArchive(ASSET_ARCHIVE_PATH);
+    inputManager->LoadBindings(INPUT_BINDINGS_PATH);
+
+    // The first scene is loaded before the first frame rather than behind an empty screen
+    scenes.Push(START_SCENE_PATH);
+    scenes.FinishLoading();
 
     running = true;
-    Run();
-    SDL_DestroyWindow(window);
     return true;
 }
 
 void Engine::Clean()
 {
-    delete scene;
+    scenes.Clear();
+    JobSystem::Instance().Shutdown();
+    profilerOverlay.Clean();
+    AnimationLibrary::Instance().Clean();
+    if (textureManager)
+        textureManager->Clean();
+    if (renderer)
+        renderer->Destroy();
+    if (window)
+    {
+        SDL_DestroyWindow(window);
+        window = nullptr;
+    }
+    SDL_Quit();
 }
 
 void Engine::Run()
 {
-    Uint64 prevTicks = SDL_GetPerformanceCounter();
-    const double freq = (double)SDL_GetPerformanceFrequency();
     while (running)
     {
-        Uint64 currTicks = SDL_GetPerformanceCounter();
-        double dt = (currTicks - prevTicks) / freq;
-        prevTicks = currTicks;
+        double dt = pacer.BeginFrame();
+        {
+            PROFILE_ZONE("Frame");
+            HandleEvents();
+            Simulate(dt);
+            Render(GetInterpolationAlpha());
+        }
+        pacer.EndFrame();
+        PROFILE_FRAME_END();
+    }
+
+    FrameTimingStats stats = GetFrameStats();
+    std::cout << "Frame time over last " << stats.samples << " frames: mean " << stats.meanMs
+              << " ms, min " << stats.minMs << " ms, max " << stats.maxMs
+              << " ms, jitter " << stats.jitterMs << " ms, work " << stats.workMs << " ms" << std::endl;
+    TextureStats textureStats = textureManager->GetStats();
+    std::cout << "Textures: " << textureStats.textures << " resident (" << textureStats.residentBytes / 1024
+              << " KiB of pixels), " << textureStats.gpuBytes / 1024 << " KiB GPU of " << textureStats.budgetBytes / 1024
+              << " KiB budget, " << textureStats.hits << " hits, " << textureStats.misses << " misses, "
+              << textureStats.evictions << " evictions" << std::endl;
+    InputLatencyStats latency = inputManager->GetLatencyStats();
+    if (latency.samples > 0)
+        std::cout << "Input to present over last " << latency.samples << " inputs: mean " << latency.meanMs
+                  << " ms, max " << latency.maxMs << " ms" << std::endl;
+}
+
+std::vector<FrameTiming> Engine::RunFrames(int frames)
+{
+    std::vector<FrameTiming> timings;
+    timings.reserve(frames);
+    const double tick = 1.0 / SIM_TICK_RATE;
+    for (int i = 0; i < frames && running; ++i)
+    {
+        // Exactly one fixed step per frame, so the run does not depend on wall-clock time
+        FrameTiming timing;
+        Uint64 start, afterEvents, afterUpdate, end;
+        {
+            PROFILE_ZONE("Frame");
+            start = SDL_GetPerformanceCounter();
+            HandleEvents();
+            afterEvents = SDL_GetPerformanceCounter();
+            Update(tick);
+            afterUpdate = SDL_GetPerformanceCounter();
+            Render();
+            end = SDL_GetPerformanceCounter();
+        }
+        PROFILE_FRAME_END();
+
+        timing.eventsMs = ElapsedMs(start, afterEvents);
+        timing.updateMs = ElapsedMs(afterEvents, afterUpdate);
+        timing.renderMs = ElapsedMs(afterUpdate, end);
+        timing.totalMs = ElapsedMs(start, end);
+        timings.push_back(timing);
+    }
+    return timings;
+}
 
-        HandleEvents();
-        Update(dt);
-        Render();
-        SDL_Delay(std::max(0, (int)(1000.0 / FPS_LIMIT - dt * 1000)));
+void Engine::Simulate(double frameTime)
+{
+    PROFILE_ZONE("Engine::Simulate");
+    const double tick = 1.0 / SIM_TICK_RATE;
+    accumulator += frameTime;
+    int steps = 0;
+    while (accumulator >= tick && steps < SIM_MAX_STEPS_PER_FRAME)
+    {
+        Update(tick);
+        accumulator -= tick;
+        ++steps;
     }
+    // Too far behind (hitch or slow machine): drop the backlog instead of spiralling
+    if (accumulator >= tick)
+        accumulator = std::fmod(accumulator, tick);
+}
+
+float Engine::GetInterpolationAlpha() const
+{
+    return static_cast<float>(accumulator * SIM_TICK_RATE);
 }
 
 void Engine::Update(double dt)
 {
+    PROFILE_ZONE("Engine::Update");
+    if (recordingMode == RecordingMode::Replay)
+    {
+        if (replayResult.replayed >= recording.GetTickCount())
+        {
+            running = false;
+            return;
+        }
+        inputManager->SetSnapshot(recording.GetInput(replayResult.replayed));
+    }
+
+    // Scenes change between steps, so a replay switches on the same step as the recording
+    scenes.Advance();
+    Scene *scene = scenes.GetActive();
     if (scene)
+    {
         scene->Update(static_cast<float>(dt));
+        scene->UpdateAnim(static_cast<float>(dt));
+    }
+
+    if (recordingMode != RecordingMode::None)
+    {
+        Uint64 checksum = scene ? scene->GetStateChecksum() : 0;
+        if (recordingMode == RecordingMode::Record)
+            recording.Append(inputManager->GetSnapshot(), checksum);
+        else
+        {
+            if (checksum != recording.GetChecksum(replayResult.replayed) && replayResult.mismatches++ == 0)
+                replayResult.firstMismatch = replayResult.replayed;
+            ++replayResult.replayed;
+        }
+    }
+    // This step has seen the presses and releases; later steps only see held actions
+    inputManager->ConsumeEdges();
 }
 
 void Engine::HandleEvents()
 {
+    PROFILE_ZONE("Engine::HandleEvents");
     inputManager->Update();
 }
 
-void Engine::Render()
+void Engine::Render(float alpha)
 {
+    PROFILE_ZONE("Engine::Render");
+    {
+        PROFILE_ZONE("TextureManager::ProcessUploads");
+        textureManager->ProcessUploads(renderer->GetSDLRenderer(), TEXTURE_UPLOAD_BUDGET_BYTES);
+    }
     renderer->Clean();
-    if (scene)
-        scene->Render(*renderer);
+    if (Scene *scene = scenes.GetActive())
+        scene->Render(*renderer, alpha);
+    if (profilerOverlay.IsVisible())
+    {
+        // Draw the queued sprites first so the overlay ends up on top
+        renderer->Flush();
+        profilerOverlay.Render(renderer->GetSDLRenderer());
+    }
     renderer->Present();
+    inputManager->OnPresent();
+}
+
+FrameTimingStats Engine::GetFrameStats() const
+{
+    return pacer.GetStats();
+}
+
+void Engine::ToggleProfilerOverlay()
+{
+#if ARROW2D_PROFILING
+    profilerOverlay.Toggle();
+#endif
 }
 
+void Engine::StartRecording()
+{
+    recording.Clear();
+    recordingMode = RecordingMode::Record;
+    // Scenes and regions must appear on the same step in the replay, whatever the disk does
+    scenes.SetSynchronous(true);
+}
+
+bool Engine::SaveRecording(const std::string& path)
+{
+    recordingMode = RecordingMode::None;
+    scenes.SetSynchronous(false);
+    return recording.Save(path);
+}
+
+bool Engine::StartReplay(const std::string& path)
+{
+    replayResult = {};
+    if (!recording.Load(path))
+    {
+        recordingMode = RecordingMode::None;
+        return false;
+    }
+    replayResult.ticks = recording.GetTickCount();
+    recordingMode = RecordingMode::Replay;
+    scenes.SetSynchronous(true);
+    return true;
+}
+
+bool Engine::IsHeadless() const { return headless; }
+
+Scene *Engine::GetScene() const { return scenes.GetActive(); }
+
+SceneManager &Engine::GetScenes() { return scenes; }
+
 void Engine::SetRunning(bool state)
 {
     running = state;
@@ -8,7 +8,37 @@ class TextureManager;
 
 #include "GameObject.hpp"
 #include "Scene.hpp"
+#include "SceneManager.hpp"
+#include "FramePacer.hpp"
+#include "ProfilerOverlay.hpp"
+#include "GameConfig.hpp"
+#include "InputRecording.hpp"
+#include <string>
+#include <vector>
 
+/**
+ * @struct FrameTiming
+ * @brief Wall-clock time spent in each phase of one frame, in milliseconds.
+ */
+struct FrameTiming
+{
+    double eventsMs = 0.0; // HandleEvents()
+    double updateMs = 0.0; // Update()
+    double renderMs = 0.0; // Render(), including present
+    double totalMs = 0.0;  // Whole frame
+};
+
+/**
+ * @struct ReplayResult
+ * @brief How a replay compared with its recording so far.
+ */
+struct ReplayResult
+{
+    size_t ticks = 0;         // Steps in the recording
+    size_t replayed = 0;      // Steps replayed so far
+    size_t mismatches = 0;    // Replayed steps whose scene checksum differed from the recording
+    size_t firstMismatch = 0; // First step that differed, valid when mismatches > 0
+};
 
 /**
  * @class Engine
@@ -29,33 +59,83 @@ class Engine
         /**
          * @brief Initializes the engine with the specified window title and dimensions.
          *
-         * This function sets the window title, width, and height for the engine,
-         * and marks the engine as running.
+         * This function initializes SDL, creates the window and renderer, loads START_SCENE_PATH
+         * as the first scene, and marks the engine as running. It does not enter the main loop; call Run() or RunFrames() next.
+         *
+         * In headless mode SDL uses the offscreen (or dummy) video driver and the software
+         * renderer, and the window is hidden, so the engine runs without a display or GPU.
          *
          * @param title The title of the window.
          * @param width The width of the window in pixels.
          * @param height The height of the window in pixels.
+         * @param headless True to run without a visible window, for benchmarks and CI.
          * @return true if initialization was successful, false otherwise.
          */
-        bool Init(const char *title, int width, int height);
+        bool Init(const char *title, int width, int height, bool headless = false);
 
         /**
          * @brief Releases resources and cleans up dynamically allocated objects.
          *
-         * This function deletes the scene object to free up memory and prevent resource leaks.
-         * It should be called during the shutdown or cleanup phase of the application.
+         * This function destroys every scene, releases textures, destroys the renderer and window,
+         * and shuts SDL down. It should be called during the shutdown or cleanup phase of the application.
          */
         void Clean();
 
+        /**
+         * @brief Runs a fixed number of frames as fast as possible and times each one.
+         *
+         * Every frame handles events, advances the simulation by exactly one fixed step and
+         * renders, without frame pacing. Stops early if the engine stops running.
+         *
+         * @param frames Number of frames to run.
+         * @return Per-frame timing data, one entry per frame that ran.
+         */
+        std::vector<FrameTiming> RunFrames(int frames);
+
+        /**
+         * @brief Checks if the engine was initialized in headless mode.
+         */
+        bool IsHeadless() const;
+
+        /**
+         * @brief Gets the active scene, the top of the scene stack, or nullptr before Init().
+         */
+        Scene *GetScene() const;
+
+        /**
+         * @brief Gets the scene stack, to push, pop or replace scenes.
+         */
+        SceneManager &GetScenes();
+
         /**
          * @brief Main loop of the engine.
          *
          * Continuously runs while the engine is active. In each iteration,
-         * it handles input events, updates the game state, and renders the scene.
+         * it handles input events, advances the simulation in fixed steps, renders
+         * the scene interpolated between the last two steps, and lets the frame pacer
+         * wait out the rest of the frame.
          * The loop exits when the 'running' flag is set to false.
          */
         void Run();
 
+        /**
+         * @brief Advances the simulation by a frame's worth of real time in fixed steps.
+         *
+         * The frame time is added to an accumulator, and Update() is called with a fixed
+         * 1 / SIM_TICK_RATE step while the accumulator holds at least one step, up to
+         * SIM_MAX_STEPS_PER_FRAME times. Any backlog left after that is dropped, so a long
+         * hitch slows the game down instead of making every following frame slower.
+         *
+         * @param frameTime Real time elapsed since the previous frame, in seconds.
+         */
+        void Simulate(double frameTime);
+
+        /**
+         * @brief Gets how far real time has progressed into the next simulation step.
+         * @return Interpolation factor in [0, 1) for rendering.
+         */
+        float GetInterpolationAlpha() const;
+
         /**
          * @brief Handles input events and updates the input manager state.
          *
@@ -69,7 +149,9 @@ class Engine
          * @brief Updates the game state based on input and elapsed time.
          *
          * This function processes input from the user, updates the scene,
-         * and handles movement logic.
+         * and handles movement logic. Called by Simulate() with a fixed step. Scene changes
+         * requested since the previous step are applied first, and a scene loading in the
+         * background advances.
          *
          * @param dt The time delta since the last update in seconds.
          */
@@ -80,8 +162,10 @@ class Engine
          *
          * This function clears the renderer, renders all game objects in the scene,
          * and presents the rendered frame to the screen.
+         *
+         * @param alpha Interpolation factor between the previous and current simulation step.
          */
-        void Render();
+        void Render(float alpha = 1.0f);
 
         /**
          * @brief Sets the running state of the engine.
@@ -93,6 +177,43 @@ class Engine
          */
         void SetRunning(bool state);
 
+        /**
+         * @brief Gets frame time and jitter statistics over the recent frames.
+         */
+        FrameTimingStats GetFrameStats() const;
+
+        /**
+         * @brief Shows or hides the profiler overlay. Does nothing in builds without profiling.
+         */
+        void ToggleProfilerOverlay();
+
+        /**
+         * @brief Starts recording the input and scene checksum of every simulation step.
+         */
+        void StartRecording();
+
+        /**
+         * @brief Stops recording and writes the recording to a file.
+         * @return true if the file was written.
+         */
+        bool SaveRecording(const std::string& path);
+
+        /**
+         * @brief Loads a recording and feeds its input to the following simulation steps.
+         *
+         * Live input is ignored while replaying. Every step's scene checksum is compared with the
+         * recorded one, and the engine stops running once the recording is used up. Replays are
+         * meant for headless runs, where RunFrames() steps exactly once per frame.
+         *
+         * @return true if the recording was loaded.
+         */
+        bool StartReplay(const std::string& path);
+
+        /**
+         * @brief Gets how the replay compared with its recording.
+         */
+        ReplayResult GetReplayResult() const { return replayResult; }
+
     private:
         /// @brief Default constructor for the Engine class.
         Engine() = default;
@@ -100,15 +221,31 @@ class Engine
         /// @brief Destructor for the Engine class.
         ~Engine() = default;
 
+        /// @brief What Update() does with the input recording.
+        enum class RecordingMode
+        {
+            None,
+            Record,
+            Replay
+        };
+
         const char *title;
         int width;
         int height;
         bool running;
+        bool headless = false;
+        SDL_Window *window = nullptr;
+        double accumulator = 0.0; // Real time not yet consumed by fixed simulation steps
+        FramePacer pacer{FPS_LIMIT, FRAME_SPIN_THRESHOLD_MS};
+        ProfilerOverlay profilerOverlay;
         Renderer *renderer;
         InputManager *inputManager;
         TextureManager *textureManager;
         GameObject *player;
-        Scene *scene;
+        SceneManager scenes; // Scene stack; the top scene is the one updated and rendered
+        InputRecording recording;
+        RecordingMode recordingMode = RecordingMode::None;
+        ReplayResult replayResult;
 };
 
 #endif // ENGINE_HPP
@@ -0,0 +1,118 @@
+#include "EntityStore.hpp"
+#include <limits>
+
+EntityId EntityStore::Create(GameObject* owner)
+{
+    EntityId id;
+    if (!freeIds.empty())
+    {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    else
+    {
+        id = static_cast<EntityId>(sparse.size());
+        sparse.push_back(INVALID_ENTITY);
+    }
+
+    sparse[id] = static_cast<Uint32>(ids.size());
+    x.push_back(0.0f);
+    y.push_back(0.0f);
+    prevX.push_back(0.0f);
+    prevY.push_back(0.0f);
+    width.push_back(0.0f);
+    height.push_back(0.0f);
+    vx.push_back(0.0f);
+    vy.push_back(0.0f);
+    hitbox.push_back({0.0f, 0.0f, 0.0f, 0.0f});
+    gridRect.push_back({0.0f, 0.0f, 0.0f, 0.0f});
+    animation.push_back(nullptr);
+    animState.push_back(AnimState::IdleLeft);
+    animFrame.push_back(0);
+    animTimer.push_back(0.0f);
+    animDuration.push_back(std::numeric_limits<float>::infinity());
+    layer.push_back(0);
+    this->owner.push_back(owner);
+    ids.push_back(id);
+    return id;
+}
+
+void EntityStore::Destroy(EntityId id)
+{
+    if (!IsValid(id))
+        return;
+
+    // Swap the last entity into the freed slot so the arrays stay contiguous
+    size_t index = sparse[id];
+    size_t last = ids.size() - 1;
+    if (index != last)
+    {
+        x[index] = x[last];
+        y[index] = y[last];
+        prevX[index] = prevX[last];
+        prevY[index] = prevY[last];
+        width[index] = width[last];
+        height[index] = height[last];
+        vx[index] = vx[last];
+        vy[index] = vy[last];
+        hitbox[index] = hitbox[last];
+        gridRect[index] = gridRect[last];
+        animation[index] = animation[last];
+        animState[index] = animState[last];
+        animFrame[index] = animFrame[last];
+        animTimer[index] = animTimer[last];
+        animDuration[index] = animDuration[last];
+        layer[index] = layer[last];
+        owner[index] = owner[last];
+        ids[index] = ids[last];
+        sparse[ids[index]] = static_cast<Uint32>(index);
+    }
+    x.pop_back();
+    y.pop_back();
+    prevX.pop_back();
+    prevY.pop_back();
+    width.pop_back();
+    height.pop_back();
+    vx.pop_back();
+    vy.pop_back();
+    hitbox.pop_back();
+    gridRect.pop_back();
+    animation.pop_back();
+    animState.pop_back();
+    animFrame.pop_back();
+    animTimer.pop_back();
+    animDuration.pop_back();
+    layer.pop_back();
+    owner.pop_back();
+    ids.pop_back();
+
+    sparse[id] = INVALID_ENTITY;
+    freeIds.push_back(id);
+}
+
+bool EntityStore::IsValid(EntityId id) const
+{
+    return id < sparse.size() && sparse[id] != INVALID_ENTITY;
+}
+
+void EntityStore::Reserve(size_t count)
+{
+    x.reserve(count);
+    y.reserve(count);
+    prevX.reserve(count);
+    prevY.reserve(count);
+    width.reserve(count);
+    height.reserve(count);
+    vx.reserve(count);
+    vy.reserve(count);
+    hitbox.reserve(count);
+    gridRect.reserve(count);
+    animation.reserve(count);
+    animState.reserve(count);
+    animFrame.reserve(count);
+    animTimer.reserve(count);
+    animDuration.reserve(count);
+    layer.reserve(count);
+    owner.reserve(count);
+    ids.reserve(count);
+}
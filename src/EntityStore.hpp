@@ -0,0 +1,83 @@
+#ifndef ENTITYSTORE_HPP
+#define ENTITYSTORE_HPP
+
+#include <SDL3/SDL.h>
+#include <vector>
+#include "GameObject.hpp"
+
+/**
+ * @class EntityStore
+ * @brief Structure-of-arrays storage for the per-frame hot state of game objects.
+ *
+ * Each field lives in its own contiguous array, indexed by a dense index in [0, Size()).
+ * Scene loops walk these arrays directly instead of chasing one heap pointer per object.
+ * Entities are referred to from outside by stable EntityIds; the dense index of an entity
+ * may change when another entity is destroyed (the last entity is swapped into the hole),
+ * so only IDs should be kept across frames.
+ *
+ * The arrays are public so systems can iterate them without accessor overhead. They must
+ * only be resized through Create() and Destroy().
+ */
+class EntityStore
+{
+    public:
+        /**
+         * @brief Creates a new entity and appends its state to the arrays.
+         * @param owner The GameObject that acts as a view onto this entity.
+         * @return The stable ID of the new entity.
+         */
+        EntityId Create(GameObject* owner);
+
+        /**
+         * @brief Destroys an entity, moving the last entity into its dense slot.
+         * @param id The entity to destroy.
+         */
+        void Destroy(EntityId id);
+
+        /**
+         * @brief Checks if an ID refers to a live entity.
+         */
+        bool IsValid(EntityId id) const;
+
+        /**
+         * @brief Gets the current dense index of a live entity.
+         * @param id A valid entity ID.
+         * @return Index into the field arrays.
+         */
+        size_t IndexOf(EntityId id) const { return sparse[id]; }
+
+        /**
+         * @brief Gets the number of live entities.
+         */
+        size_t Size() const { return ids.size(); }
+
+        /**
+         * @brief Reserves capacity in every array.
+         * @param count Number of entities to reserve space for.
+         */
+        void Reserve(size_t count);
+
+        std::vector<float> x, y;            ///< Top-left position in world space.
+        std::vector<float> prevX, prevY;    ///< Position at the start of the last simulation step, for interpolation.
+        std::vector<float> width, height;   ///< Render size.
+        std::vector<float> vx, vy;          ///< Velocity in pixels per second.
+        std::vector<SDL_FRect> hitbox;      ///< Collision rectangle in world space, kept at (x, y).
+        std::vector<SDL_FRect> gridRect;    ///< Rectangle the entity is filed under in the scene's collision grid; only the Scene writes it.
+        std::vector<const AnimationSet*> animation; ///< Shared clips, kept alive by the owner; may be nullptr.
+        std::vector<AnimState> animState;   ///< Current animation state, selects the clip.
+        std::vector<Uint16> animFrame;      ///< Current frame within the clip.
+        std::vector<float> animTimer;       ///< Seconds spent on the current frame.
+        std::vector<float> animDuration;    ///< Seconds the current frame is shown, cached from the clip; infinite if it never advances.
+        std::vector<int> layer;             ///< Draw layer, lower layers are drawn first.
+        std::vector<GameObject*> owner;     ///< Object that owns each entity (for behavior callbacks).
+        std::vector<EntityId> ids;          ///< Dense index to entity ID.
+
+    private:
+        /// @brief Entity ID to dense index; INVALID_ENTITY marks a free slot.
+        std::vector<Uint32> sparse;
+
+        /// @brief Released IDs, reused before new ones are minted.
+        std::vector<EntityId> freeIds;
+};
+
+#endif // ENTITYSTORE_HPP
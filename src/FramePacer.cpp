@@ -0,0 +1,103 @@
+#include "FramePacer.hpp"
+#include <algorithm>
+#include <cmath>
+
+FramePacer::FramePacer(int targetFps, double spinThresholdMs, size_t historySize)
+    : frequency(SDL_GetPerformanceFrequency()), frameTimes(historySize, 0), workTimes(historySize, 0)
+{
+    spinThreshold = static_cast<Uint64>(spinThresholdMs * frequency / 1000.0);
+    SetTargetFps(targetFps);
+}
+
+void FramePacer::SetTargetFps(int targetFps)
+{
+    period = targetFps > 0 ? frequency / targetFps : 0;
+    deadline = 0;
+}
+
+void FramePacer::SetVSync(bool enabled)
+{
+    vsync = enabled;
+    deadline = 0;
+}
+
+double FramePacer::BeginFrame()
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 elapsed = frameStart ? now - frameStart : 0;
+    if (frameStart && count > 0)
+    {
+        // The previous frame is complete now that its full length is known
+        size_t slot = (next + frameTimes.size() - 1) % frameTimes.size();
+        frameTimes[slot] = elapsed;
+        lastComplete = slot;
+        completed = std::min(completed + 1, frameTimes.size());
+    }
+    frameStart = now;
+    return static_cast<double>(elapsed) / frequency;
+}
+
+void FramePacer::EndFrame()
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    workTimes[next] = now - frameStart;
+    next = (next + 1) % frameTimes.size();
+    count = std::min(count + 1, frameTimes.size());
+
+    if (vsync || period == 0)
+        return;
+
+    // Deadlines advance by exactly one period; if we fell more than a frame behind, re-anchor
+    // on this frame instead of rushing several short frames to catch up.
+    if (deadline == 0 || now > deadline + period)
+        deadline = frameStart + period;
+    else
+        deadline += period;
+    if (now < deadline)
+        WaitUntil(deadline);
+}
+
+void FramePacer::WaitUntil(Uint64 target) const
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (target > now + spinThreshold)
+    {
+        Uint64 sleepTicks = target - now - spinThreshold;
+        SDL_DelayNS(static_cast<Uint64>(static_cast<double>(sleepTicks) * SDL_NS_PER_SECOND / frequency));
+    }
+    // Spin out the tail for precision
+    while (SDL_GetPerformanceCounter() < target)
+    {
+    }
+}
+
+FrameTimingStats FramePacer::GetStats() const
+{
+    FrameTimingStats stats;
+    size_t samples = completed;
+    if (samples == 0)
+        return stats;
+
+    double toMs = 1000.0 / frequency;
+    double sum = 0.0, sumSq = 0.0, work = 0.0;
+    double minMs = 1e300, maxMs = 0.0;
+    size_t size = frameTimes.size();
+    for (size_t k = 0; k < samples; ++k)
+    {
+        // Walk back from the most recent completed frame
+        size_t i = (lastComplete + size - k) % size;
+        double ms = frameTimes[i] * toMs;
+        sum += ms;
+        sumSq += ms * ms;
+        work += workTimes[i] * toMs;
+        minMs = std::min(minMs, ms);
+        maxMs = std::max(maxMs, ms);
+    }
+    stats.samples = samples;
+    stats.meanMs = sum / samples;
+    stats.minMs = minMs;
+    stats.maxMs = maxMs;
+    stats.jitterMs = std::sqrt(std::max(0.0, sumSq / samples - stats.meanMs * stats.meanMs));
+    stats.workMs = work / samples;
+    return stats;
+}
@@ -0,0 +1,97 @@
+#ifndef FRAMEPACER_HPP
+#define FRAMEPACER_HPP
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+/**
+ * @struct FrameTimingStats
+ * @brief Summary of recent frame times, in milliseconds.
+ */
+struct FrameTimingStats
+{
+    size_t samples = 0;   // Number of frames the summary covers
+    double meanMs = 0.0;  // Average frame-to-frame time
+    double minMs = 0.0;   // Shortest frame
+    double maxMs = 0.0;   // Longest frame
+    double jitterMs = 0.0; // Standard deviation of the frame time
+    double workMs = 0.0;  // Average time spent working (before waiting) per frame
+};
+
+/**
+ * @class FramePacer
+ * @brief Holds a steady frame rate with sub-millisecond precision.
+ *
+ * Frames are paced against absolute deadlines on the performance counter, so waiting
+ * always accounts for the current frame's own work time and rounding never accumulates.
+ * Most of the wait is spent in an OS sleep; the last stretch (the spin threshold) is spent
+ * polling the counter, because sleeps can overshoot by a millisecond or more.
+ *
+ * With VSync enabled the pacer never waits, since presenting already blocks on the display,
+ * but it still measures frame and work times.
+ *
+ * Usage:
+ *   - Call BeginFrame() at the top of each frame; it returns the time since the previous one.
+ *   - Call EndFrame() after presenting to wait out the rest of the frame.
+ *   - Use GetStats() to read frame time and jitter statistics over the recent history.
+ */
+class FramePacer
+{
+    public:
+        /**
+         * @brief Constructs a pacer.
+         * @param targetFps Frame rate to hold, or 0 for no limit.
+         * @param spinThresholdMs How long before the deadline to stop sleeping and start spinning.
+         * @param historySize Number of recent frames kept for statistics.
+         */
+        FramePacer(int targetFps, double spinThresholdMs, size_t historySize = 240);
+
+        /**
+         * @brief Marks the start of a frame.
+         * @return Seconds since the previous BeginFrame() (0 on the first call).
+         */
+        double BeginFrame();
+
+        /**
+         * @brief Marks the end of a frame's work and waits until the frame's deadline.
+         */
+        void EndFrame();
+
+        /**
+         * @brief Tells the pacer whether presenting is synchronized to the display.
+         * @param enabled True if the renderer has VSync on; the pacer then stops waiting.
+         */
+        void SetVSync(bool enabled);
+
+        /**
+         * @brief Changes the target frame rate.
+         * @param targetFps Frame rate to hold, or 0 for no limit.
+         */
+        void SetTargetFps(int targetFps);
+
+        /**
+         * @brief Summarizes the frames in the history.
+         */
+        FrameTimingStats GetStats() const;
+
+    private:
+        /// @brief Sleeps, then spins, until the performance counter reaches @p deadline.
+        void WaitUntil(Uint64 deadline) const;
+
+        Uint64 frequency;
+        Uint64 period = 0;        // Frame length in counter ticks (0 = unlimited)
+        Uint64 spinThreshold;     // Counter ticks before the deadline to start spinning
+        Uint64 frameStart = 0;
+        Uint64 deadline = 0;
+        bool vsync = false;
+
+        // Ring buffers of recent frame and work times, in counter ticks
+        std::vector<Uint64> frameTimes;
+        std::vector<Uint64> workTimes;
+        size_t next = 0;          // Slot of the frame in progress
+        size_t count = 0;         // Slots holding a work time
+        size_t lastComplete = 0;  // Slot of the newest frame with both times known
+        size_t completed = 0;     // Slots holding both times
+};
+
+#endif // FRAMEPACER_HPP
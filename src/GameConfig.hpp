@@ -9,13 +9,66 @@ constexpr int WINDOW_WIDTH = 960;
 constexpr int WINDOW_HEIGHT = 540;
 constexpr SDL_WindowFlags WINDOW_FLAGS = SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIGH_PIXEL_DENSITY | SDL_WINDOW_INPUT_FOCUS;
 constexpr int FPS_LIMIT = 240;
+constexpr const char* HEADLESS_VIDEO_DRIVERS = "offscreen,dummy"; // Video drivers tried, in order, in headless mode
+constexpr bool VSYNC_ENABLED = false; // Sync presents to the display; the frame pacer then stops waiting
+constexpr double FRAME_SPIN_THRESHOLD_MS = 1.5; // Final part of each frame wait spent spinning instead of sleeping
+
+// Simulation settings
+constexpr int SIM_TICK_RATE = 120; // Fixed simulation steps per second, independent of frame rate
+constexpr int SIM_MAX_STEPS_PER_FRAME = 8; // Steps allowed per frame before the backlog is dropped
+
+// Threading settings
+constexpr int JOB_WORKER_THREADS = -1; // Job system workers besides the main thread; -1 uses one per remaining hardware thread
+constexpr size_t JOB_MIN_BATCH = 256; // Fewest entities per parallel-for batch in Scene::Update
+
+// Memory settings
+constexpr Uint32 OBJECT_POOL_BLOCK_SLOTS = 256; // Objects per block in each of a scene's object pools
+constexpr size_t SCENE_ARENA_BLOCK_BYTES = 256 * 1024; // Block size of each scene's arena
+
+// Render settings
+constexpr bool RENDER_BATCH_SPRITES = true; // Queue sprites and draw one SDL_RenderGeometry call per texture run
+constexpr int ATLAS_PAGE_SIZE = 2048; // Width and height of each texture atlas page
+constexpr int ATLAS_PADDING = 2; // Transparent border around each packed image, in pixels
+constexpr const char* ASSET_ARCHIVE_PATH = "assets.pak"; // Packed assets written by Arrow2D_pack; loose files are used if missing
+constexpr size_t TEXTURE_UPLOAD_BUDGET_BYTES = 4 * 1024 * 1024; // Decoded pixels uploaded to the GPU per frame; the rest wait
+constexpr size_t TEXTURE_MEMORY_BUDGET_BYTES = 256 * 1024 * 1024; // GPU memory for textures (atlas pages plus standalone textures) kept before unreferenced textures are evicted
+constexpr float STATIC_LAYER_CHUNK_SIZE = 512.0f; // Width and height of a static layer chunk in pixels; each visible chunk is one cached texture
+constexpr size_t STATIC_LAYER_CHUNK_CACHE = 64; // Chunk textures kept per static layer before the least recently drawn are released
+constexpr int STATIC_LAYER_BAKES_PER_FRAME = 4; // Chunks a static layer redraws per frame; the rest are drawn sprite by sprite meanwhile
+constexpr float CULL_MARGIN = 64.0f; // How far a sprite may extend past its hitbox and still be culled correctly
+
+// Profiler settings (overlay only exists when built with ARROW2D_PROFILING)
+constexpr const char* PROFILER_FONT_PATH = "assets/OpenSans-Regular.ttf"; // Font for the profiler overlay
+constexpr float PROFILER_FONT_SIZE = 14.0f; // Overlay text size in points
+constexpr bool PROFILER_OVERLAY_VISIBLE = false; // Show the overlay at startup
+
+// Tilemap settings
+constexpr int TILEMAP_CHUNK_TILES = 16; // Width and height of a tilemap chunk in tiles; each visible chunk is one cached texture
+constexpr size_t TILEMAP_CHUNK_CACHE = 64; // Chunk textures kept before the least recently drawn are released
+constexpr int TILEMAP_DRAW_LAYER = -100; // Draw layer of a tilemap's first layer; the others follow, all below sprites
+
+// World streaming settings
+constexpr float WORLD_LOAD_MARGIN = 512.0f; // Regions this close to the camera start loading
+constexpr float WORLD_UNLOAD_MARGIN = 1024.0f; // Regions are unloaded only once this far from the camera, so moving back and forth does not thrash
+constexpr size_t WORLD_SPAWN_BUDGET = 2000; // Objects and sprites streamed regions may create per step, in total
+
+// Scene loading settings
+constexpr const char* START_SCENE_PATH = "assets/scenes/Test.scene"; // Scene loaded by Engine::Init
+constexpr size_t SCENE_BUILD_BUDGET = 5000; // Objects and sprites a scene loading behind the current one creates per step
 
 // Player settings
 constexpr float PLAYER_SPEED = 350.0f; // Speed in pixels per second
 constexpr float PLAYER_HOR_SIZE = 44.0f; // Horizontal size of the player sprite
 constexpr float PLAYER_VER_SIZE = PLAYER_HOR_SIZE * 3 / 2; // Vertical size of the player sprite
 
-// Key mapping for movement (customizable)
+// Collision settings
+constexpr float COLLISION_CELL_SIZE = 128.0f; // Broadphase grid cell size in pixels (a few sprite widths)
+
+// Input settings
+constexpr const char* INPUT_BINDINGS_PATH = "assets/config/Bindings.cfg"; // Key bindings loaded at startup; the keys below are the defaults
+constexpr size_t INPUT_LATENCY_HISTORY = 120; // Frames with input kept for the input-to-present latency stats
+
+// Default key bindings (overridden by INPUT_BINDINGS_PATH)
 constexpr SDL_Scancode KEY_MOVE_UP    = SDL_SCANCODE_W;
 constexpr SDL_Scancode KEY_MOVE_DOWN  = SDL_SCANCODE_S;
 constexpr SDL_Scancode KEY_MOVE_LEFT  = SDL_SCANCODE_A;
@@ -25,4 +78,7 @@ constexpr SDL_Scancode KEY_DOWN_ALT   = SDL_SCANCODE_DOWN;
 constexpr SDL_Scancode KEY_LEFT_ALT   = SDL_SCANCODE_LEFT;
 constexpr SDL_Scancode KEY_RIGHT_ALT  = SDL_SCANCODE_RIGHT;
 
+// Debug keys
+constexpr SDL_Scancode KEY_TOGGLE_PROFILER = SDL_SCANCODE_F3;
+
 #endif // GAME_CONFIG_HPP
\ No newline at end of file
@@ -1,111 +1,256 @@
 #include "GameObject.hpp"
+#include "EntityStore.hpp"
 #include "GameConfig.hpp"
+#include "TextureManager.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
-GameObject::GameObject(float x, float y, float width, float height, const std::unordered_map<AnimState, SDL_Texture*>& textures)
-    : x(x), y(y), width(width), height(height), vx(0), vy(0), textures(textures), animState(AnimState::IdleLeft), animTimer(0.0f), wasFacingRight(true), wasMoving(false)
+GameObject::GameObject(float x, float y, float width, float height, AnimationSetRef animation)
+    : animation(std::move(animation)), animState(AnimState::IdleLeft), x(x), y(y), width(width), height(height), vx(0), vy(0)
 {
     hitbox = {x, y, width, height};
 }
 
+GameObject::~GameObject()
+{
+    DetachFromStore();
+}
+
+void GameObject::AttachToStore(EntityStore *store)
+{
+    if (this->store || !store)
+        return;
+    entity = store->Create(this);
+    this->store = store;
+    size_t i = store->IndexOf(entity);
+    store->x[i] = x;
+    store->y[i] = y;
+    store->prevX[i] = x;
+    store->prevY[i] = y;
+    store->width[i] = width;
+    store->height[i] = height;
+    store->vx[i] = vx;
+    store->vy[i] = vy;
+    store->hitbox[i] = hitbox;
+    store->animState[i] = animState;
+    store->animation[i] = animation.get();
+    store->animFrame[i] = animFrame;
+    store->animTimer[i] = animTimer;
+    store->animDuration[i] = animation ? animation->GetFrameDuration(animState, animFrame) : std::numeric_limits<float>::infinity();
+    store->layer[i] = layer;
+}
+
+void GameObject::DetachFromStore()
+{
+    if (!store)
+        return;
+    size_t i = store->IndexOf(entity);
+    x = store->x[i];
+    y = store->y[i];
+    vx = store->vx[i];
+    vy = store->vy[i];
+    hitbox = store->hitbox[i];
+    animState = store->animState[i];
+    animFrame = store->animFrame[i];
+    animTimer = store->animTimer[i];
+    layer = store->layer[i];
+    store->Destroy(entity);
+    store = nullptr;
+    entity = INVALID_ENTITY;
+}
+
+EntityId GameObject::GetEntityId() const { return entity; }
+
 void GameObject::Update(float dt)
 {
     // Only update per-frame logic (animation, timers, etc.)
     this->dt = dt;
 }
 
+bool GameObject::RequiresMainThread() const { return false; }
+
 void GameObject::Render(SDL_Renderer *renderer, float offsetX, float offsetY)
 {
     // Render the current animation state's texture at the object's position, applying camera offset
-    SDL_FRect destRect = { x - offsetX, y - offsetY, width, height };
-    SDL_Texture* tex = nullptr;
-    if (textures.count(animState))
-        tex = textures.at(animState);
-    if (tex)
-        SDL_RenderTexture(renderer, tex, nullptr, &destRect);
+    SDL_FRect destRect = { GetX() - offsetX, GetY() - offsetY, width, height };
+    const TextureRegion &region = TextureManager::Instance().Resolve(GetTexture());
+    if (region.texture)
+        SDL_RenderTexture(renderer, region.texture, &region.src, &destRect);
+}
+
+const TextureHandle &GameObject::GetTexture() const 
+{ 
+    // Return the texture handle for the current animation frame, or an empty handle if there is none
+    static const TextureHandle none;
+    if (!animation)
+        return none;
+    return animation->GetFrameTexture(GetAnimState(), GetAnimFrame());
+}
+
+const AnimationSet *GameObject::GetAnimation() const { return animation.get(); }
+
+bool GameObject::Intersects(const GameObject& other) const 
+{
+    return Intersects(GetHitbox(), other.GetHitbox());
+}
+
+bool GameObject::Intersects(const SDL_FRect& a, const SDL_FRect& b) 
+{
+    return (a.x < b.x + b.w && a.x + a.w > b.x &&
+            a.y < b.y + b.h && a.y + a.h > b.y);
 }
 
-void GameObject::UpdateAnim(float dt, bool moving, bool facingRight)
+SweepHit GameObject::Sweep(const SDL_FRect& moving, float dx, float dy, const SDL_FRect& obstacle)
 {
-    animTimer += dt;
-    const float animFrameTime = 0.10f;
-    if (!moving)
+    // Most obstacles are nowhere near the path; reject them before dividing
+    SDL_FRect path = { std::min(moving.x, moving.x + dx), std::min(moving.y, moving.y + dy), moving.w + std::fabs(dx), moving.h + std::fabs(dy) };
+    if (!Intersects(path, obstacle))
+        return {};
+
+    // Grow the obstacle by the moving box's size (Minkowski sum) so the mover becomes its top-left
+    // corner, then clip that point's path against the grown box one axis at a time (slab test).
+    const float inf = std::numeric_limits<float>::infinity();
+    float minX = obstacle.x - moving.w, maxX = obstacle.x + obstacle.w;
+    float minY = obstacle.y - moving.h, maxY = obstacle.y + obstacle.h;
+    float entryX = -inf, exitX = inf, entryY = -inf, exitY = inf;
+    if (dx != 0.0f)
     {
-        if (facingRight)
-            animState = AnimState::IdleRight;
-        else
-            animState = AnimState::IdleLeft;
-        animTimer = 0.0f;
+        float t0 = (minX - moving.x) / dx, t1 = (maxX - moving.x) / dx;
+        entryX = std::min(t0, t1);
+        exitX = std::max(t0, t1);
     }
-    else
+    else if (moving.x <= minX || moving.x >= maxX)
+        return {}; // Never overlaps horizontally
+    if (dy != 0.0f)
     {
-        if (!wasMoving || wasFacingRight != facingRight)
-            animTimer = 0.0f; // Reset timer when starting to move or changing direction
-        if (animTimer >= animFrameTime)
-        {
-            // Toggle frame
-            if (facingRight)
-            {
-                if (animState == AnimState::WalkRightA)
-                    animState = AnimState::WalkRightB;
-                else
-                    animState = AnimState::WalkRightA;
-            }
-            else
-            {
-                if (animState == AnimState::WalkLeftA)
-                    animState = AnimState::WalkLeftB;
-                else
-                    animState = AnimState::WalkLeftA;
-            }
-            animTimer = 0.0f;
-        }
+        float t0 = (minY - moving.y) / dy, t1 = (maxY - moving.y) / dy;
+        entryY = std::min(t0, t1);
+        exitY = std::max(t0, t1);
+    }
+    else if (moving.y <= minY || moving.y >= maxY)
+        return {};
+
+    float entry = std::max(entryX, entryY);
+    float exit = std::min(exitX, exitY);
+    if (entry >= exit || entry >= 1.0f || exit <= 0.0f)
+        return {};
+
+    SweepHit hit;
+    hit.time = 0.0f;
+    if (entry >= 0.0f)
+    {
+        hit.time = entry;
+        if (entryX > entryY)
+            hit.normalX = dx > 0.0f ? -1.0f : 1.0f;
         else
-        {
-            // Keep current frame
-            if (facingRight && (animState != AnimState::WalkRightA && animState != AnimState::WalkRightB))
-                animState = AnimState::WalkRightA;
-            if (!facingRight && (animState != AnimState::WalkLeftA && animState != AnimState::WalkLeftB))
-                animState = AnimState::WalkLeftA;
-        }
+            hit.normalY = dy > 0.0f ? -1.0f : 1.0f;
+        return hit;
     }
-    wasMoving = moving;
-    wasFacingRight = facingRight;
+
+    // Already overlapping: find the shallower axis and block only motion that goes deeper
+    float depthX = std::min(moving.x + moving.w - obstacle.x, obstacle.x + obstacle.w - moving.x);
+    float depthY = std::min(moving.y + moving.h - obstacle.y, obstacle.y + obstacle.h - moving.y);
+    if (depthX < depthY)
+        hit.normalX = moving.x + moving.w / 2 < obstacle.x + obstacle.w / 2 ? -1.0f : 1.0f;
+    else
+        hit.normalY = moving.y + moving.h / 2 < obstacle.y + obstacle.h / 2 ? -1.0f : 1.0f;
+    if (dx * hit.normalX + dy * hit.normalY < 0.0f)
+        return hit;
+    return {};
 }
 
-SDL_Texture *GameObject::GetTexture() const 
-{ 
-    // Return the texture for the current animation state, or nullptr if not found
-    auto it = textures.find(animState);
-    if (it == textures.end())
-        return nullptr;
-    return it->second;
+SDL_FRect GameObject::GetDestRect() const { return { GetX(), GetY(), width, height }; }
+
+float GameObject::GetWidth() const { return width; }
+float GameObject::GetHeight() const { return height; }
+float GameObject::GetVX() const { return store ? store->vx[store->IndexOf(entity)] : vx; }
+float GameObject::GetVY() const { return store ? store->vy[store->IndexOf(entity)] : vy; }
+float GameObject::GetX() const { return store ? store->x[store->IndexOf(entity)] : x; }
+float GameObject::GetY() const { return store ? store->y[store->IndexOf(entity)] : y; }
+SDL_FRect GameObject::GetHitbox() const { return store ? store->hitbox[store->IndexOf(entity)] : hitbox; }
+AnimState GameObject::GetAnimState() const { return store ? store->animState[store->IndexOf(entity)] : animState; }
+Uint16 GameObject::GetAnimFrame() const { return store ? store->animFrame[store->IndexOf(entity)] : animFrame; }
+int GameObject::GetLayer() const { return store ? store->layer[store->IndexOf(entity)] : layer; }
+
+void GameObject::SetVX(float vx)
+{
+    if (store)
+        store->vx[store->IndexOf(entity)] = vx;
+    else
+        this->vx = vx;
 }
 
-bool GameObject::Intersects(const GameObject& other) const 
+void GameObject::SetVY(float vy)
 {
-    return Intersects(this->hitbox, other.hitbox);
+    if (store)
+        store->vy[store->IndexOf(entity)] = vy;
+    else
+        this->vy = vy;
 }
 
-bool GameObject::Intersects(const SDL_FRect& a, const SDL_FRect& b) 
+void GameObject::SetX(float x)
 {
-    return (a.x < b.x + b.w && a.x + a.w > b.x &&
-            a.y < b.y + b.h && a.y + a.h > b.y);
+    if (store)
+    {
+        size_t i = store->IndexOf(entity);
+        store->x[i] = x;
+        store->hitbox[i].x = x;
+    }
+    else
+        this->x = x;
 }
 
-SDL_FRect GameObject::GetDestRect() const { return { x, y, width, height }; }
+void GameObject::SetY(float y)
+{
+    if (store)
+    {
+        size_t i = store->IndexOf(entity);
+        store->y[i] = y;
+        store->hitbox[i].y = y;
+    }
+    else
+        this->y = y;
+}
 
-float GameObject::GetWidth() const { return width; }
-float GameObject::GetHeight() const { return height; }
-float GameObject::GetVX() const { return vx; }
-float GameObject::GetVY() const { return vy; }
-float GameObject::GetX() const { return x; }
-float GameObject::GetY() const { return y; }
-SDL_FRect GameObject::GetHitbox() const { return hitbox; }
-AnimState GameObject::GetAnimState() const { return animState; }
-
-void GameObject::SetVX(float vx) { this->vx = vx; }
-void GameObject::SetVY(float vy) { this->vy = vy; }
-void GameObject::SetX(float x) { this->x = x; }
-void GameObject::SetY(float y) { this->y = y; }
-void GameObject::SetHitbox(const SDL_FRect& rect) { hitbox = rect; }
-void GameObject::SetAnimState(AnimState state) { animState = state; }
+void GameObject::SetHitbox(const SDL_FRect& rect)
+{
+    if (store)
+    {
+        size_t i = store->IndexOf(entity);
+        store->hitbox[i] = rect;
+        store->x[i] = rect.x;
+        store->y[i] = rect.y;
+    }
+    else
+        hitbox = rect;
+}
+
+void GameObject::SetLayer(int layer)
+{
+    if (store)
+        store->layer[store->IndexOf(entity)] = layer;
+    else
+        this->layer = layer;
+}
+
+void GameObject::SetAnimState(AnimState state)
+{
+    if (store)
+    {
+        size_t i = store->IndexOf(entity);
+        if (store->animState[i] != state)
+        {
+            store->animState[i] = state;
+            store->animFrame[i] = 0;
+            store->animTimer[i] = 0.0f;
+            store->animDuration[i] = animation ? animation->GetFrameDuration(state, 0) : std::numeric_limits<float>::infinity();
+        }
+    }
+    else if (animState != state)
+    {
+        animState = state;
+        animFrame = 0;
+        animTimer = 0.0f;
+    }
+}
@@ -2,14 +2,28 @@
 #define GAMEOBJECT_HPP
 
 #include <SDL3/SDL.h>
-#include <unordered_map>
-#include <string>
+#include "AnimationSet.hpp"
+
+/// @brief Stable identifier of an entity inside an EntityStore.
+using EntityId = Uint32;
+
+/// @brief Sentinel for "no entity".
+constexpr EntityId INVALID_ENTITY = 0xFFFFFFFFu;
+
+class EntityStore;
 
 /**
- * @enum AnimState
- * @brief Represents animation states for any game object.
+ * @struct SweepHit
+ * @brief Result of GameObject::Sweep(): when and on which face a moving box first touches an obstacle.
  */
-enum class AnimState { IdleLeft, IdleRight, WalkLeftA, WalkLeftB, WalkRightA, WalkRightB };
+struct SweepHit
+{
+    float time = 1.0f; // Fraction of the move done at contact, in [0, 1); 1 when nothing is hit
+    float normalX = 0.0f, normalY = 0.0f; // Normal of the face hit, pointing back at the mover; zero when nothing is hit
+
+    /// @brief Checks if the move is blocked.
+    bool Hit() const { return normalX != 0.0f || normalY != 0.0f; }
+};
 
 /**
  * @class GameObject
@@ -21,14 +35,20 @@ enum class AnimState { IdleLeft, IdleRight, WalkLeftA, WalkLeftB, WalkRightA, Wa
  *
  * Key Features:
  * - Stores and manages the object's position (x, y) and velocity (vx, vy).
- * - Associates animation states with SDL_Texture pointers for rendering.
+ * - Plays clips from a shared, immutable AnimationSet; the object only keeps its state, frame and frame timer.
  * - Provides methods to update the object's state each frame, including animation state transitions.
  * - Supports setting and retrieving position, velocity, and animation state.
- * - Handles animation timing and switching between idle and walking states based on movement and direction.
+ * - Once in a Scene, its animation is advanced by the scene's AnimationSystem from its velocity.
  *
  * Usage:
  * - Derive from GameObject to implement specific game entities.
- * - Override Update and UpdateAnim methods to provide custom behavior.
+ * - Override Update to provide custom behavior.
+ *
+ * Storage:
+ * - A standalone GameObject keeps its position, velocity, hitbox and animation state in its own fields.
+ * - Once attached to an EntityStore (Scene::AddObject does this), that state lives in the store's
+ *   contiguous arrays and the accessors below read and write through to it, so the object becomes
+ *   a thin view plus behavior on top of the entity.
  *
  * @note This class assumes the existence of AnimState enum and SDL2 types.
  */
@@ -47,6 +67,21 @@ class GameObject
          */
         static bool Intersects(const SDL_FRect& a, const SDL_FRect& b);
 
+        /**
+         * @brief Swept AABB test: finds when a box moving by (dx, dy) first touches a static box.
+         *
+         * Touching counts as contact, so a box resting against an obstacle is blocked from moving
+         * into it but free to slide along it or move away. A box that already overlaps the obstacle
+         * is only blocked from moving deeper along the axis of least penetration.
+         *
+         * @param moving The moving box at the start of the move.
+         * @param dx Horizontal displacement over the whole move.
+         * @param dy Vertical displacement over the whole move.
+         * @param obstacle The box to test against.
+         * @return Time of impact and face normal; SweepHit::Hit() is false if the whole move is free.
+         */
+        static SweepHit Sweep(const SDL_FRect& moving, float dx, float dy, const SDL_FRect& obstacle);
+
         /**
          * @brief Gets the object's hitbox rectangle (for collision detection).
          * @return SDL_FRect representing the hitbox.
@@ -55,23 +90,60 @@ class GameObject
 
         /**
          * @brief Sets the object's hitbox rectangle.
+         *
+         * Once attached to an entity store the hitbox is kept at the object's position, so this
+         * also moves the object to (rect.x, rect.y).
+         *
          * @param rect The new hitbox rectangle.
          */
         void SetHitbox(const SDL_FRect& rect);
         /**
-         * @brief Constructs a GameObject at the specified position with associated textures for animation states.
+         * @brief Constructs a GameObject at the specified position, animated by a shared set of clips.
          * 
          * @param x The x-coordinate of the GameObject's position.
          * @param y The y-coordinate of the GameObject's position.
-         * @param textures A map associating each AnimState with its corresponding SDL_Texture pointer.
+         * @param animation The clips to play, kept alive by the object. May be nullptr for an invisible object.
+         */
+        GameObject(float x, float y, float width, float height, AnimationSetRef animation);
+
+        /**
+         * @brief Virtual destructor for safe polymorphic deletion. Detaches from the entity store, if any.
+         */
+        virtual ~GameObject();
+
+        /**
+         * @brief Moves this object's hot state into an entity store.
+         *
+         * A new entity is created in @p store and initialized from the object's current fields.
+         * From then on all accessors operate on the store.
+         *
+         * @param store The store to attach to. The object must not already be attached.
+         */
+        void AttachToStore(EntityStore* store);
+
+        /**
+         * @brief Copies the hot state back out of the entity store and destroys the entity.
          */
-        GameObject(float x, float y, float width, float height, const std::unordered_map<AnimState, SDL_Texture*>& textures);
+        void DetachFromStore();
+
+        /**
+         * @brief Gets the ID of this object's entity, or INVALID_ENTITY when not attached.
+         */
+        EntityId GetEntityId() const;
 
         /**
          * @brief Updates the game object each frame.
          * @param dt Time delta since last update (in seconds).
          */
         virtual void Update(float dt);
+
+        /**
+         * @brief Checks if Update() must run on the main thread.
+         *
+         * Scene runs Update() for most objects on worker threads, where it may only touch the
+         * object's own state. Objects that call into shared systems that are not thread-safe return true.
+         */
+        virtual bool RequiresMainThread() const;
        
         /**
          * @brief Renders the game object using the specified SDL renderer.
@@ -81,10 +153,15 @@ class GameObject
         void Render(SDL_Renderer *renderer, float offsetX = 0.0f, float offsetY = 0.0f);
 
         /**
-         * @brief Returns the texture for the current animation state, or nullptr if not found.
-         * @return SDL_Texture* for the current animation state.
+         * @brief Returns the texture handle for the current animation frame.
+         * @return The handle to resolve through the TextureManager, or an empty handle if there is none.
          */
-        SDL_Texture *GetTexture() const;
+        const TextureHandle &GetTexture() const;
+
+        /**
+         * @brief Gets the animation set this object plays clips from.
+         */
+        const AnimationSet *GetAnimation() const;
 
         /**
          * @brief Returns the destination rectangle for rendering.
@@ -103,12 +180,12 @@ class GameObject
         float GetHeight() const;
 
         /**
-         * @brief Sets the object's X position.
+         * @brief Sets the object's X position. Once attached to an entity store, the hitbox moves with it.
          * @param x The new X position value to set.
          */
         void SetX(float x);
         /**
-         * @brief Sets the object's Y position.
+         * @brief Sets the object's Y position. Once attached to an entity store, the hitbox moves with it.
          * @param y The new Y position value to set.
          */
         void SetY(float y);
@@ -150,7 +227,7 @@ class GameObject
         /**
          * @brief Sets the animation state of the game object.
          * 
-         * This function updates the current animation state to the specified value.
+         * Switching to a different state restarts its clip from the first frame.
          * 
          * @param state The new animation state to set for the game object.
          */
@@ -162,40 +239,39 @@ class GameObject
         AnimState GetAnimState() const;
 
         /**
-         * @brief Updates the animation state of the GameObject based on movement and direction.
-         *
-         * This function manages the animation timer and switches between idle and walking animation states
-         * depending on whether the object is moving and which direction it is facing. It toggles between
-         * animation frames at a fixed interval when moving, and resets the animation state and timer when
-         * the movement state or facing direction changes.
-         *
-         * @param dt Time elapsed since the last update (in seconds).
-         * @param moving Indicates whether the GameObject is currently moving.
-         * @param facingRight Indicates whether the GameObject is facing right (true) or left (false).
-         */
-        virtual void UpdateAnim(float dt, bool moving, bool facingRight);
-
-    protected:
-        /// @brief Maps animation states to their corresponding SDL textures.
-        /// 
-        /// This unordered_map associates each AnimState (representing a specific animation state)
-        /// with a pointer to an SDL_Texture, allowing efficient retrieval of the correct texture
-        /// for rendering based on the current animation state.
-        std::unordered_map<AnimState, SDL_Texture*> textures;
-
-        /// @brief Represents the current animation state of the game object.
-        /// Used to control and track which animation is active for this object.
-        AnimState animState;
+         * @brief Gets the index of the current frame within the current state's clip.
+         */
+        Uint16 GetAnimFrame() const;
+
+        /**
+         * @brief Sets the draw layer. Lower layers are drawn first when sprites are batched.
+         * @param layer The new layer (0 by default).
+         */
+        void SetLayer(int layer);
+
+        /**
+         * @brief Gets the object's draw layer.
+         */
+        int GetLayer() const;
 
     private:
+        /// @brief Store holding this object's hot state, or nullptr when standalone.
+        EntityStore *store = nullptr;
+        EntityId entity = INVALID_ENTITY;
+
+        /// @brief Shared clips; the entity store's pointer to them is valid while this holds them.
+        AnimationSetRef animation;
+
+        // Local state, only authoritative while not attached to a store
+        AnimState animState;
+        Uint16 animFrame = 0;
+        float animTimer = 0.0f;
+        int layer = 0;
         float x, y;
         float width, height;
         SDL_FRect hitbox; // Collision rectangle
         float vx, vy;
         float dt; // Delta time for movement
-        float animTimer = 0.0f;
-        bool wasMoving = false;
-        bool wasFacingRight = true;
 };
 
 #endif // GAMEOBJECT_HPP
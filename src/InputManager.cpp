@@ -1,17 +1,49 @@
 #include "InputManager.hpp"
 #include "GameConfig.hpp"
+#include "TextureManager.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 
-InputManager& InputManager::Instance() 
+namespace
+{
+    /// @brief Action names used in bindings files, in InputAction order.
+    constexpr const char* ACTION_NAMES[INPUT_ACTION_COUNT] =
+    {
+        "move_up",
+        "move_down",
+        "move_left",
+        "move_right",
+        "toggle_profiler"
+    };
+
+    constexpr Uint32 Bit(InputAction action) { return Uint32(1) << static_cast<Uint32>(action); }
+
+    constexpr float DIAGONAL = 0.70710678f; // 1 / sqrt(2): length of each axis of a unit diagonal
+}
+
+InputManager& InputManager::Instance()
 {
     static InputManager instance;
     return instance;
 }
 
+InputManager::InputManager()
+{
+    ResetBindings();
+}
+
 /// @brief Updates the input manager state each frame.
-/// Call this function once per frame to process input events and update internal states.
+/// Call this function once per frame to process input events and take the snapshot.
 void InputManager::Update()
 {
+    // The latency timestamp belongs to one frame; held actions carry over, and edges last
+    // until a simulation step consumes them
+    snapshot.eventNs = 0;
+    ++snapshot.frame;
     ProcessInput();
+    UpdateMovement();
+    latencyEventNs = snapshot.eventNs;
 }
 
 /// @brief Processes input events from the SDL event queue.
@@ -23,29 +55,212 @@ void InputManager::ProcessInput()
     {
         if (event.type == SDL_EVENT_QUIT)
             Engine::Instance().SetRunning(false);
+        else if ((event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP) && !event.key.repeat)
+            OnKey(event.key.scancode, event.type == SDL_EVENT_KEY_DOWN, event.key.timestamp);
+        else if (event.type == SDL_EVENT_WINDOW_FOCUS_LOST)
+            ReleaseAllKeys(event.common.timestamp);
+    }
+}
+
+void InputManager::OnKey(SDL_Scancode key, bool down, Uint64 timestampNs)
+{
+    if (key <= SDL_SCANCODE_UNKNOWN || key >= SDL_SCANCODE_COUNT || keys[key] == down)
+        return;
+    keys[key] = down;
+    Uint32 changed = 0;
+    for (size_t a = 0; a < INPUT_ACTION_COUNT; ++a)
+    {
+        Uint32 bit = Uint32(1) << a;
+        if (!(keyActions[key] & bit))
+            continue;
+        // An action is held while any of its keys is
+        if (down && heldKeys[a]++ == 0)
+        {
+            snapshot.down |= bit;
+            snapshot.pressed |= bit;
+            changed |= bit;
+        }
+        else if (!down && heldKeys[a] > 0 && --heldKeys[a] == 0)
+        {
+            snapshot.down &= ~bit;
+            snapshot.released |= bit;
+            changed |= bit;
+        }
+    }
+    if (changed && snapshot.eventNs == 0)
+        snapshot.eventNs = timestampNs;
+    if (changed & snapshot.down & Bit(InputAction::ToggleProfiler))
+        Engine::Instance().ToggleProfilerOverlay();
+}
+
+void InputManager::ReleaseAllKeys(Uint64 timestampNs)
+{
+    for (size_t key = 0; key < keys.size(); ++key)
+    {
+        if (keys[key])
+            OnKey(static_cast<SDL_Scancode>(key), false, timestampNs);
+    }
+}
+
+void InputManager::UpdateMovement()
+{
+    float x = static_cast<float>(snapshot.IsDown(InputAction::MoveRight)) - static_cast<float>(snapshot.IsDown(InputAction::MoveLeft));
+    float y = static_cast<float>(snapshot.IsDown(InputAction::MoveDown)) - static_cast<float>(snapshot.IsDown(InputAction::MoveUp));
+    // Normalize: the only non-unit direction is a diagonal
+    float scale = (x != 0.0f && y != 0.0f) ? DIAGONAL : 1.0f;
+    snapshot.moveX = x * scale;
+    snapshot.moveY = y * scale;
+}
+
+void InputManager::ConsumeEdges()
+{
+    snapshot.pressed = 0;
+    snapshot.released = 0;
+}
+
+void InputManager::SetSnapshot(const InputSnapshot& input)
+{
+    snapshot.down = input.down;
+    snapshot.pressed = input.pressed;
+    snapshot.released = input.released;
+    UpdateMovement();
+}
+
+bool InputManager::IsKeyDown(SDL_Scancode key) const
+{
+    return key > SDL_SCANCODE_UNKNOWN && key < SDL_SCANCODE_COUNT && keys[key];
+}
+
+void InputManager::GetMovementVector(float& vx, float& vy, float speed) const
+{
+    vx = snapshot.moveX * speed;
+    vy = snapshot.moveY * speed;
+}
+
+void InputManager::Bind(InputAction action, SDL_Scancode key)
+{
+    if (action >= InputAction::Count || key <= SDL_SCANCODE_UNKNOWN || key >= SDL_SCANCODE_COUNT || (keyActions[key] & Bit(action)))
+        return;
+    keyActions[key] |= Bit(action);
+    if (keys[key] && heldKeys[static_cast<size_t>(action)]++ == 0)
+        snapshot.down |= Bit(action);
+}
+
+void InputManager::Unbind(InputAction action)
+{
+    if (action >= InputAction::Count)
+        return;
+    for (Uint32& actions : keyActions)
+        actions &= ~Bit(action);
+    heldKeys[static_cast<size_t>(action)] = 0;
+    snapshot.down &= ~Bit(action);
+}
+
+void InputManager::ResetBindings()
+{
+    for (size_t a = 0; a < INPUT_ACTION_COUNT; ++a)
+        Unbind(static_cast<InputAction>(a));
+    Bind(InputAction::MoveUp, KEY_MOVE_UP);
+    Bind(InputAction::MoveUp, KEY_UP_ALT);
+    Bind(InputAction::MoveDown, KEY_MOVE_DOWN);
+    Bind(InputAction::MoveDown, KEY_DOWN_ALT);
+    Bind(InputAction::MoveLeft, KEY_MOVE_LEFT);
+    Bind(InputAction::MoveLeft, KEY_LEFT_ALT);
+    Bind(InputAction::MoveRight, KEY_MOVE_RIGHT);
+    Bind(InputAction::MoveRight, KEY_RIGHT_ALT);
+    Bind(InputAction::ToggleProfiler, KEY_TOGGLE_PROFILER);
+}
+
+bool InputManager::LoadBindings(const std::string& path)
+{
+    // Prefer the packed copy, read straight from the mapped archive
+    std::string text;
+    const AssetArchive& archive = TextureManager::Instance().GetArchive();
+    if (const ArchiveEntry* packed = archive.Find(path))
+        text.assign(static_cast<const char*>(archive.GetData(*packed)), packed->size);
+    else
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            SDL_Log("Failed to open key bindings %s, using the defaults", path.c_str());
+            return false;
+        }
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        text = contents.str();
+    }
+
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        std::string name;
+        if (!(fields >> name) || name[0] == '#')
+            continue;
+        const char* const* found = std::find_if(std::begin(ACTION_NAMES), std::end(ACTION_NAMES), [&](const char* n) { return name == n; });
+        if (found == std::end(ACTION_NAMES))
+        {
+            SDL_Log("Key bindings %s: unknown action \"%s\"", path.c_str(), name.c_str());
+            continue;
+        }
+        InputAction action = static_cast<InputAction>(found - std::begin(ACTION_NAMES));
+        Unbind(action);
+        std::string keyName;
+        while (fields >> keyName)
+        {
+            SDL_Scancode key = SDL_GetScancodeFromName(keyName.c_str());
+            if (key == SDL_SCANCODE_UNKNOWN)
+                SDL_Log("Key bindings %s: unknown key \"%s\" for %s", path.c_str(), keyName.c_str(), name.c_str());
+            else
+                Bind(action, key);
+        }
     }
+    return true;
 }
 
-bool InputManager::IsKeyDown(SDL_Scancode key)
+std::vector<SDL_Scancode> InputManager::GetBindings(InputAction action) const
 {
-    const bool* state = SDL_GetKeyboardState(NULL);
-    bool pressed = state != nullptr && state[key];
-    return pressed;
+    std::vector<SDL_Scancode> bound;
+    if (action >= InputAction::Count)
+        return bound;
+    for (size_t key = 0; key < keyActions.size(); ++key)
+    {
+        if (keyActions[key] & Bit(action))
+            bound.push_back(static_cast<SDL_Scancode>(key));
+    }
+    return bound;
 }
 
-void InputManager::GetMovementVector(float& vx, float& vy, float speed)
+const char* InputManager::GetActionName(InputAction action)
 {
-    vx = 0.0f;
-    vy = 0.0f;
-    if (IsKeyDown(KEY_MOVE_UP)    || IsKeyDown(KEY_UP_ALT))    vy -= 1.0f;
-    if (IsKeyDown(KEY_MOVE_DOWN)  || IsKeyDown(KEY_DOWN_ALT))  vy += 1.0f;
-    if (IsKeyDown(KEY_MOVE_LEFT)  || IsKeyDown(KEY_LEFT_ALT))  vx -= 1.0f;
-    if (IsKeyDown(KEY_MOVE_RIGHT) || IsKeyDown(KEY_RIGHT_ALT)) vx += 1.0f;
-    // Normalize
-    float len = sqrtf(vx * vx + vy * vy);
-    if (len > 0.0f) 
+    return action < InputAction::Count ? ACTION_NAMES[static_cast<size_t>(action)] : "";
+}
+
+void InputManager::OnPresent()
+{
+    if (latencyEventNs == 0)
+        return;
+    float ms = static_cast<float>((SDL_GetTicksNS() - latencyEventNs) / 1e6);
+    if (latencyHistoryMs.size() < INPUT_LATENCY_HISTORY)
+        latencyHistoryMs.push_back(ms);
+    else
+        latencyHistoryMs[latencyNext] = ms;
+    latencyNext = (latencyNext + 1) % INPUT_LATENCY_HISTORY;
+    latencyEventNs = 0; // Later presents of the same snapshot show nothing new
+}
+
+InputLatencyStats InputManager::GetLatencyStats() const
+{
+    InputLatencyStats stats;
+    stats.samples = latencyHistoryMs.size();
+    for (float ms : latencyHistoryMs)
     {
-        vx = (vx / len) * speed;
-        vy = (vy / len) * speed;
+        stats.meanMs += ms;
+        stats.maxMs = std::max(stats.maxMs, static_cast<double>(ms));
     }
-}
\ No newline at end of file
+    if (stats.samples > 0)
+        stats.meanMs /= stats.samples;
+    return stats;
+}
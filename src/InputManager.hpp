@@ -2,23 +2,88 @@
 #define INPUTMANAGER_HPP
 
 #include <SDL3/SDL.h>
+#include <array>
+#include <string>
+#include <vector>
 #include "Engine.hpp"
 
+/**
+ * @enum InputAction
+ * @brief Things the player can do, each bound to one or more keys.
+ */
+enum class InputAction : Uint8
+{
+    MoveUp,
+    MoveDown,
+    MoveLeft,
+    MoveRight,
+    ToggleProfiler,
+    Count
+};
+
+/// @brief Number of input actions.
+constexpr size_t INPUT_ACTION_COUNT = static_cast<size_t>(InputAction::Count);
+
+/**
+ * @struct InputSnapshot
+ * @brief The state of every action for one frame, taken once by InputManager::Update().
+ *
+ * Action states are bit sets indexed by InputAction, so reading one costs a mask test. The
+ * pressed and released edges also catch a key tapped and let go within a single frame. Edges
+ * are kept until a simulation step has seen them, so a frame that runs no step does not lose them.
+ */
+struct InputSnapshot
+{
+    Uint32 down = 0;     // Actions held at the end of the frame's events
+    Uint32 pressed = 0;  // Actions that went down since the last simulation step
+    Uint32 released = 0; // Actions that went up since the last simulation step
+    float moveX = 0.0f;  // Movement direction from the move actions, length 1 or 0
+    float moveY = 0.0f;
+    Uint64 frame = 0;    // Number of Update() calls so far
+    Uint64 eventNs = 0;  // SDL timestamp of the first action change this frame, or 0 if none
+
+    bool IsDown(InputAction action) const { return (down >> static_cast<Uint32>(action)) & 1; }
+    bool WasPressed(InputAction action) const { return (pressed >> static_cast<Uint32>(action)) & 1; }
+    bool WasReleased(InputAction action) const { return (released >> static_cast<Uint32>(action)) & 1; }
+};
+
+/**
+ * @struct InputLatencyStats
+ * @brief Time from input events to the present of the frame that first reflected them.
+ */
+struct InputLatencyStats
+{
+    size_t samples = 0; // Frames with an action change among the recent history
+    double meanMs = 0.0;
+    double maxMs = 0.0;
+};
+
 /**
  * @class InputManager
  * @brief Singleton class responsible for handling input events and state.
  *
- * The InputManager class manages keyboard input for the application. It provides
- * methods to update input state, process SDL events, query key states, and calculate
- * movement vectors based on user input. Designed as a singleton to ensure a single
- * point of input management throughout the application.
+ * The InputManager class manages keyboard input for the application. Each frame, Update()
+ * drains the SDL event queue once, applies key events to its own key table and folds them into
+ * an InputSnapshot of action states. Every query afterwards reads that snapshot, so any number
+ * of input-driven objects cost the same as one, and no query calls into SDL.
+ *
+ * Actions are bound to keys at runtime. The defaults come from GameConfig; LoadBindings()
+ * replaces them from a file of lines naming an action and its keys:
+ * @code
+ * # action     keys (SDL scancode names)
+ * move_up      W Up
+ * move_left    A Left
+ * @endcode
+ *
+ * Input latency: every snapshot keeps the SDL timestamp of its first action change. The engine
+ * calls OnPresent() after presenting the frame, which records the time from that event to the
+ * present, the part of input-to-photon latency the engine controls. The display adds its own
+ * scan-out delay on top.
  *
  * Usage:
  *   - Call InputManager::Instance() to access the singleton instance.
- *   - Call Update() once per frame to refresh input states.
- *   - Use ProcessInput() to handle SDL input events.
- *   - Use IsKeyDown() to check if a specific key is pressed.
- *   - Use GetMovementVector() to obtain normalized movement vectors based on input.
+ *   - Call Update() once per frame to process events and take the snapshot.
+ *   - Read GetSnapshot(), or use IsActionDown(), IsKeyDown() and GetMovementVector().
  */
 class InputManager
 {
@@ -29,43 +94,134 @@ class InputManager
         static InputManager& Instance();
 
         /**
-         * @brief Updates the input manager state each frame.
+         * @brief Processes this frame's events and takes the input snapshot.
          */
         void Update();
 
         /**
          * @brief Processes input events from the SDL event queue.
+         *
+         * Key events update the key table and the current snapshot's edges; quit and the
+         * profiler toggle are handled here.
          */
         void ProcessInput();
 
+        /**
+         * @brief Clears the pressed and released edges once a simulation step has read them.
+         *
+         * Call after each step. Frames that run no step keep their edges for the next one.
+         */
+        void ConsumeEdges();
+
+        /**
+         * @brief Gets the snapshot taken by the last Update().
+         */
+        const InputSnapshot& GetSnapshot() const { return snapshot; }
+
+        /**
+         * @brief Replaces the action states of the current snapshot, e.g. with recorded input.
+         *
+         * The movement direction is worked out from the new states. Keys held on the keyboard
+         * are not affected, and the states last until the next key event or SetSnapshot().
+         *
+         * @param input Snapshot whose down, pressed and released states to use.
+         */
+        void SetSnapshot(const InputSnapshot& input);
+
+        /**
+         * @brief Checks if an action is held in the current snapshot.
+         */
+        bool IsActionDown(InputAction action) const { return snapshot.IsDown(action); }
+
         /**
          * @brief Checks if a specific keyboard key is currently pressed.
          *
-         * This function queries the current state of the keyboard and returns true
-         * if the specified SDL_Scancode key is being held down.
+         * Reads the key table kept from events, not the live keyboard state.
          *
          * @param key The SDL_Scancode representing the key to check.
          * @return true if the key is currently pressed, false otherwise.
          */
-        bool IsKeyDown(SDL_Scancode key);
+        bool IsKeyDown(SDL_Scancode key) const;
 
         /**
          * @brief Gets the movement vector based on current input and speed.
          *
-         * This function calculates the movement vector based on the current input state,
-         * normalizes it, and scales it by the specified speed. It updates the provided
-         * vx and vy parameters with the calculated values.
+         * The direction is worked out once per frame when the snapshot is taken; this only
+         * scales it by @p speed.
          *
          * @param vx Reference to store the calculated X velocity.
          * @param vy Reference to store the calculated Y velocity.
          * @param speed The speed to scale the movement vector.
          */
-        void GetMovementVector(float& vx, float& vy, float speed);
+        void GetMovementVector(float& vx, float& vy, float speed) const;
+
+        /**
+         * @brief Binds a key to an action, in addition to the keys already bound to it.
+         */
+        void Bind(InputAction action, SDL_Scancode key);
+
+        /**
+         * @brief Removes every key bound to an action.
+         */
+        void Unbind(InputAction action);
+
+        /**
+         * @brief Restores the bindings from GameConfig.
+         */
+        void ResetBindings();
+
+        /**
+         * @brief Replaces the bindings of the actions listed in a bindings file.
+         *
+         * The copy in the mounted asset archive is used when there is one. Actions the file does
+         * not mention keep their bindings.
+         *
+         * @param path Path of the bindings file.
+         * @return true if the file was read; unknown actions and keys are logged and skipped.
+         */
+        bool LoadBindings(const std::string& path);
+
+        /**
+         * @brief Gets the keys bound to an action.
+         */
+        std::vector<SDL_Scancode> GetBindings(InputAction action) const;
+
+        /**
+         * @brief Gets the name an action has in bindings files, e.g. "move_up".
+         */
+        static const char* GetActionName(InputAction action);
+
+        /**
+         * @brief Records the latency of the current snapshot's input. Call right after presenting.
+         */
+        void OnPresent();
+
+        /**
+         * @brief Gets input-to-present latency over the recent frames that had input.
+         */
+        InputLatencyStats GetLatencyStats() const;
 
     private:
         /// @brief Default constructor for the InputManager class.
-        ///        Initializes a new instance of InputManager with default settings.
-        InputManager() = default;
+        ///        Initializes the bindings from GameConfig.
+        InputManager();
+
+        /// @brief Applies a key going down or up to the key table and the snapshot.
+        void OnKey(SDL_Scancode key, bool down, Uint64 timestampNs);
+
+        /// @brief Releases every key, e.g. when the window loses focus and key-up events are missed.
+        void ReleaseAllKeys(Uint64 timestampNs);
+
+        /// @brief Recomputes the movement direction from the move actions.
+        void UpdateMovement();
+
+        InputSnapshot snapshot;
+        std::array<bool, SDL_SCANCODE_COUNT> keys = {};         // Keys held, from events
+        std::array<Uint32, SDL_SCANCODE_COUNT> keyActions = {}; // Actions bound to each key
+        std::array<Uint8, INPUT_ACTION_COUNT> heldKeys = {};    // Held keys bound to each action
+        Uint64 latencyEventNs = 0; // Input timestamp OnPresent() has yet to measure
+        std::vector<float> latencyHistoryMs;
+        size_t latencyNext = 0;
 };
 
 #endif // INPUTMANAGER_HPP
@@ -0,0 +1,107 @@
+#include "InputRecording.hpp"
+#include "GameConfig.hpp"
+#include "InputManager.hpp"
+#include <cstring>
+#include <fstream>
+
+void InputRecording::Clear()
+{
+    ticks.clear();
+    checksums.clear();
+}
+
+void InputRecording::Append(const InputSnapshot &input, Uint64 checksum)
+{
+    ticks.push_back({ input.down, input.pressed, input.released });
+    checksums.push_back(checksum);
+}
+
+InputSnapshot InputRecording::GetInput(size_t tick) const
+{
+    InputSnapshot input;
+    input.down = ticks[tick].down;
+    input.pressed = ticks[tick].pressed;
+    input.released = ticks[tick].released;
+    return input;
+}
+
+bool InputRecording::Save(const std::string &path) const
+{
+    // Merge steps with identical input into runs
+    std::vector<RecordingRun> runs;
+    for (const Tick &tick : ticks)
+    {
+        if (!runs.empty() && runs.back().down == tick.down && runs.back().pressed == tick.pressed && runs.back().released == tick.released)
+            ++runs.back().ticks;
+        else
+            runs.push_back({ 1, tick.down, tick.pressed, tick.released });
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+    {
+        SDL_Log("Failed to create recording %s", path.c_str());
+        return false;
+    }
+    RecordingHeader header = {};
+    std::memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+    header.version = RECORDING_VERSION;
+    header.tickRate = SIM_TICK_RATE;
+    header.tickCount = static_cast<Uint32>(ticks.size());
+    header.runCount = static_cast<Uint32>(runs.size());
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(runs.data()), static_cast<std::streamsize>(runs.size() * sizeof(RecordingRun)));
+    out.write(reinterpret_cast<const char *>(checksums.data()), static_cast<std::streamsize>(checksums.size() * sizeof(Uint64)));
+    if (!out)
+    {
+        SDL_Log("Failed to write recording %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool InputRecording::Load(const std::string &path)
+{
+    Clear();
+    std::ifstream in(path, std::ios::binary);
+    RecordingHeader header = {};
+    if (!in || !in.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    {
+        SDL_Log("Failed to read recording %s", path.c_str());
+        return false;
+    }
+    if (std::memcmp(header.magic, RECORDING_MAGIC, sizeof(header.magic)) != 0 || header.version != RECORDING_VERSION)
+    {
+        SDL_Log("%s is not a version %u recording", path.c_str(), RECORDING_VERSION);
+        return false;
+    }
+    if (header.tickRate != static_cast<Uint32>(SIM_TICK_RATE))
+    {
+        SDL_Log("Recording %s was made at %u steps per second, not %d", path.c_str(), header.tickRate, SIM_TICK_RATE);
+        return false;
+    }
+
+    if (header.runCount > header.tickCount)
+    {
+        SDL_Log("Recording %s is corrupt", path.c_str());
+        return false;
+    }
+    std::vector<RecordingRun> runs(header.runCount);
+    checksums.resize(header.tickCount);
+    in.read(reinterpret_cast<char *>(runs.data()), static_cast<std::streamsize>(runs.size() * sizeof(RecordingRun)));
+    in.read(reinterpret_cast<char *>(checksums.data()), static_cast<std::streamsize>(checksums.size() * sizeof(Uint64)));
+    ticks.reserve(header.tickCount);
+    for (const RecordingRun &run : runs)
+    {
+        if (run.ticks > header.tickCount - ticks.size())
+            break; // Runs cover more steps than the header says; caught below
+        ticks.insert(ticks.end(), run.ticks, Tick{ run.down, run.pressed, run.released });
+    }
+    if (!in || ticks.size() != checksums.size())
+    {
+        SDL_Log("Recording %s is truncated or corrupt", path.c_str());
+        Clear();
+        return false;
+    }
+    return true;
+}
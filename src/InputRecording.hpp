@@ -0,0 +1,118 @@
+#ifndef INPUTRECORDING_HPP
+#define INPUTRECORDING_HPP
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+struct InputSnapshot;
+
+/**
+ * Input recording (.a2r) format.
+ *
+ * A recording holds the input every simulation step saw and a checksum of the scene state
+ * after that step. It starts with a RecordingHeader, followed by runCount RecordingRun records
+ * and then tickCount 64-bit checksums, one per step. Input changes far less often than every
+ * step, so consecutive steps with identical input share one run. All fields are little-endian.
+ */
+
+constexpr char RECORDING_MAGIC[8] = { 'A', '2', 'D', 'R', 'E', 'C', '\0', '\0' };
+constexpr Uint32 RECORDING_VERSION = 1;
+
+/**
+ * @struct RecordingHeader
+ * @brief First bytes of a recording file.
+ */
+struct RecordingHeader
+{
+    char magic[8];    // RECORDING_MAGIC
+    Uint32 version;   // RECORDING_VERSION
+    Uint32 tickRate;  // Simulation steps per second the recording was made at
+    Uint32 tickCount; // Steps recorded, and checksums stored
+    Uint32 runCount;  // RecordingRun records that follow the header
+};
+
+/**
+ * @struct RecordingRun
+ * @brief A run of consecutive steps that saw the same input.
+ */
+struct RecordingRun
+{
+    Uint32 ticks;    // Steps in the run
+    Uint32 down;     // InputSnapshot::down
+    Uint32 pressed;  // InputSnapshot::pressed
+    Uint32 released; // InputSnapshot::released
+};
+
+static_assert(sizeof(RecordingHeader) == 24, "RecordingHeader layout is part of the file format");
+static_assert(sizeof(RecordingRun) == 16, "RecordingRun layout is part of the file format");
+
+/**
+ * @class InputRecording
+ * @brief The input and resulting state checksum of every simulation step of a session.
+ *
+ * The engine appends one step at a time while recording and reads them back in order while
+ * replaying. Since the simulation runs in fixed steps and does not depend on the thread count,
+ * feeding the same input to the same scene gives the same checksums, so a replay on a new build
+ * shows both how fast it runs and whether it still simulates the same thing.
+ */
+class InputRecording
+{
+    public:
+        /**
+         * @brief Removes every step.
+         */
+        void Clear();
+
+        /**
+         * @brief Records one simulation step.
+         * @param input The input snapshot the step ran with.
+         * @param checksum Scene::GetStateChecksum() after the step.
+         */
+        void Append(const InputSnapshot &input, Uint64 checksum);
+
+        /**
+         * @brief Gets the number of recorded steps.
+         */
+        size_t GetTickCount() const { return checksums.size(); }
+
+        /**
+         * @brief Gets the input of a step. Only the action states are recorded.
+         */
+        InputSnapshot GetInput(size_t tick) const;
+
+        /**
+         * @brief Gets the scene checksum recorded after a step.
+         */
+        Uint64 GetChecksum(size_t tick) const { return checksums[tick]; }
+
+        /**
+         * @brief Writes the recording to a file.
+         * @return true if the file was written.
+         */
+        bool Save(const std::string &path) const;
+
+        /**
+         * @brief Replaces the recording with one read from a file.
+         *
+         * Recordings made at a different SIM_TICK_RATE are rejected, since they would not replay
+         * the same simulation.
+         *
+         * @return true on success. On failure the recording is left empty and the reason is logged.
+         */
+        bool Load(const std::string &path);
+
+    private:
+        /// @brief Input of one step, as stored in memory.
+        struct Tick
+        {
+            Uint32 down;
+            Uint32 pressed;
+            Uint32 released;
+        };
+
+        std::vector<Tick> ticks;
+        std::vector<Uint64> checksums;
+};
+
+#endif // INPUTRECORDING_HPP
@@ -0,0 +1,227 @@
+#include "JobSystem.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+
+namespace
+{
+    // Queue owned by the calling thread; 0 for the main thread and any thread outside the pool
+    thread_local size_t currentQueue = 0;
+}
+
+JobSystem& JobSystem::Instance()
+{
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::JobSystem()
+{
+    queues.push_back(std::make_unique<WorkQueue>());
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void JobSystem::Init(int workerCount)
+{
+    Shutdown();
+    if (workerCount < 0)
+        workerCount = std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+
+    // Shutdown() ran every queued job, so no handle is left waiting on a dropped queue
+    queues.clear();
+    for (int i = 0; i <= workerCount; ++i)
+        queues.push_back(std::make_unique<WorkQueue>());
+    stopping = false;
+    for (int i = 1; i <= workerCount; ++i)
+        workers.emplace_back(&JobSystem::WorkerLoop, this, static_cast<size_t>(i));
+}
+
+void JobSystem::Shutdown()
+{
+    // Drain anything still queued so no job is silently dropped
+    while (RunOne(0))
+        ;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers)
+        worker.join();
+    workers.clear();
+    // Jobs a worker queued for itself as it stopped; run them so nobody waits on them forever
+    while (RunOne(0))
+        ;
+}
+
+int JobSystem::GetWorkerCount() const
+{
+    return static_cast<int>(workers.size());
+}
+
+JobHandle JobSystem::Schedule(std::function<void()> work, const std::vector<JobHandle> &dependencies)
+{
+    JobHandle job = std::make_shared<Job>();
+    job->work = std::move(work);
+    for (const JobHandle &dependency : dependencies)
+    {
+        if (!dependency)
+            continue;
+        std::lock_guard<std::mutex> lock(dependency->mutex);
+        if (!dependency->done.load(std::memory_order_relaxed))
+        {
+            job->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+            dependency->continuations.push_back(job);
+        }
+    }
+    // Drop the scheduling reference; queue the job now if nothing is left to wait for
+    if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        Push(job);
+    return job;
+}
+
+void JobSystem::Wait(const JobHandle &job)
+{
+    if (!job)
+        return;
+    while (!job->done.load(std::memory_order_acquire))
+    {
+        if (!RunOne(currentQueue))
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t minBatch, const std::function<void(size_t, size_t)> &fn)
+{
+    if (count == 0)
+        return;
+    minBatch = std::max<size_t>(minBatch, 1);
+    if (workers.empty() || count <= minBatch)
+    {
+        fn(0, count);
+        return;
+    }
+
+    // A few batches per thread so claiming can even out uneven batches
+    size_t maxBatches = (workers.size() + 1) * 4;
+    size_t batches = std::min(maxBatches, (count + minBatch - 1) / minBatch);
+    size_t batchSize = (count + batches - 1) / batches;
+    batches = (count + batchSize - 1) / batchSize;
+
+    // Threads claim batches from a shared counter. The caller claims too and then only waits for
+    // the batches others are still running, never picking up unrelated queued jobs such as file
+    // reads. Helpers that start after every batch is claimed touch nothing but the counters,
+    // which they keep alive, so they may safely outlive this call.
+    struct Batches
+    {
+        const std::function<void(size_t, size_t)> *fn;
+        size_t count, batchSize, batches;
+        std::atomic<size_t> next{ 0 };
+        std::atomic<size_t> finished{ 0 };
+    };
+    auto shared = std::make_shared<Batches>();
+    shared->fn = &fn;
+    shared->count = count;
+    shared->batchSize = batchSize;
+    shared->batches = batches;
+    auto runBatches = [](Batches &b)
+    {
+        for (size_t batch = b.next.fetch_add(1, std::memory_order_relaxed); batch < b.batches; batch = b.next.fetch_add(1, std::memory_order_relaxed))
+        {
+            size_t begin = batch * b.batchSize;
+            (*b.fn)(begin, std::min(b.count, begin + b.batchSize));
+            b.finished.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    size_t helpers = std::min(workers.size(), batches - 1);
+    for (size_t i = 0; i < helpers; ++i)
+        Schedule([shared, runBatches]() { runBatches(*shared); });
+    runBatches(*shared);
+    while (shared->finished.load(std::memory_order_acquire) < batches)
+        std::this_thread::yield();
+}
+
+void JobSystem::Push(JobHandle job)
+{
+    WorkQueue &queue = *queues[currentQueue < queues.size() ? currentQueue : 0];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    queuedJobs.fetch_add(1, std::memory_order_release);
+    // Taking the sleep lock orders this push against a worker that is about to sleep
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+void JobSystem::Execute(const JobHandle &job)
+{
+    {
+        PROFILE_ZONE("Job");
+        job->work();
+    }
+
+    std::vector<JobHandle> ready;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->done.store(true, std::memory_order_release);
+        ready.swap(job->continuations);
+    }
+    for (JobHandle &continuation : ready)
+    {
+        if (continuation->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Push(std::move(continuation));
+    }
+}
+
+bool JobSystem::RunOne(size_t queueIndex)
+{
+    if (queues.empty())
+        return false;
+
+    JobHandle job;
+    // Newest job from our own queue first, then steal the oldest from the others
+    for (size_t n = 0; n < queues.size() && !job; ++n)
+    {
+        WorkQueue &queue = *queues[(queueIndex + n) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+            continue;
+        if (n == 0)
+        {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+        }
+        else
+        {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+    }
+    if (!job)
+        return false;
+
+    queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    Execute(job);
+    return true;
+}
+
+void JobSystem::WorkerLoop(size_t queueIndex)
+{
+    currentQueue = queueIndex;
+    while (true)
+    {
+        if (RunOne(queueIndex))
+            continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return stopping || queuedJobs.load(std::memory_order_acquire) > 0; });
+        if (stopping && queuedJobs.load(std::memory_order_acquire) == 0)
+            break;
+    }
+}
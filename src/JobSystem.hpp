@@ -0,0 +1,121 @@
+#ifndef JOBSYSTEM_HPP
+#define JOBSYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct Job
+ * @brief A unit of work plus the jobs waiting on it. Created by JobSystem::Schedule().
+ */
+struct Job
+{
+    std::function<void()> work;
+    std::atomic<int> pendingDependencies{ 1 }; // Unfinished dependencies, plus one while scheduling
+    std::atomic<bool> done{ false };
+    std::mutex mutex; // Guards continuations and the transition to done
+    std::vector<std::shared_ptr<Job>> continuations; // Jobs that depend on this one
+};
+
+using JobHandle = std::shared_ptr<Job>;
+
+/**
+ * @class JobSystem
+ * @brief Singleton worker pool with work-stealing queues, job dependencies and parallel-for.
+ *
+ * Every worker, and the main thread, owns a queue. A thread pushes new jobs onto its own
+ * queue and pops from the back of it (most recent first, which keeps its data hot); idle
+ * threads steal from the front of the other queues. A thread that waits on a job runs
+ * queued jobs meanwhile instead of blocking, so waiting never wastes a core.
+ *
+ * With zero workers (the default before Init(), or on a single-core machine) every job
+ * runs on the thread that waits for it, so code using the job system never needs a
+ * separate serial path.
+ *
+ * Usage:
+ *   - Call Init() once at startup and Shutdown() before exit.
+ *   - Use Schedule() with optional dependencies, then Wait() on the handle.
+ *   - Use ParallelFor() to split a loop over [0, count) into batches across the workers.
+ */
+class JobSystem
+{
+    public:
+        /// @brief Returns the singleton instance of the JobSystem.
+        static JobSystem& Instance();
+
+        /**
+         * @brief Starts the worker threads. Calling it again restarts the pool with the new count.
+         * @param workerCount Number of workers; negative uses one per hardware thread besides the main one.
+         */
+        void Init(int workerCount);
+
+        /**
+         * @brief Finishes all queued jobs, including any the workers queue as they stop, and joins the workers.
+         */
+        void Shutdown();
+
+        /**
+         * @brief Gets the number of worker threads (not counting the main thread).
+         */
+        int GetWorkerCount() const;
+
+        /**
+         * @brief Queues a job to run once all of its dependencies have finished.
+         * @param work The function to run.
+         * @param dependencies Jobs that must finish first; finished or null handles are ignored.
+         * @return Handle to wait on or to pass as a dependency of later jobs.
+         */
+        JobHandle Schedule(std::function<void()> work, const std::vector<JobHandle> &dependencies = {});
+
+        /**
+         * @brief Blocks until the job has finished, running other queued jobs meanwhile.
+         */
+        void Wait(const JobHandle &job);
+
+        /**
+         * @brief Runs fn over [0, count) in contiguous batches and returns when all are done.
+         *
+         * Each index is visited exactly once. Batches run in any order and on any thread, so
+         * fn must only write state owned by the indices it is given. While waiting, the caller
+         * only runs batches of this loop, so a long job queued elsewhere, such as a file read,
+         * never holds it up.
+         *
+         * @param count Number of indices.
+         * @param minBatch Smallest batch worth handing to another thread.
+         * @param fn Called as fn(begin, end) for each batch.
+         */
+        void ParallelFor(size_t count, size_t minBatch, const std::function<void(size_t, size_t)> &fn);
+
+        ~JobSystem();
+
+    private:
+        /// @brief Creates the main thread's queue; no workers run until Init().
+        JobSystem();
+
+        /// @brief A thread's double-ended job queue.
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<JobHandle> jobs;
+        };
+
+        void Push(JobHandle job);
+        void Execute(const JobHandle &job);
+        bool RunOne(size_t queueIndex);
+        void WorkerLoop(size_t queueIndex);
+
+        std::vector<std::unique_ptr<WorkQueue>> queues; // Index 0 belongs to the main thread
+        std::vector<std::thread> workers;
+        std::atomic<int> queuedJobs{ 0 };
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        bool stopping = false;
+};
+
+#endif // JOBSYSTEM_HPP
@@ -1,8 +1,5 @@
 #pragma once
 #include "GameObject.hpp"
-#include <string>
-#include <map>
-#include "TextureManager.hpp"
 
 /**
  * @class NPC
@@ -18,12 +15,10 @@ public:
      * @param y Initial Y position.
      * @param width Width of the NPC.
      * @param height Height of the NPC.
-     * @param textures Map of animation states to texture file paths.
+     * @param animation Shared clips to play, from AnimationLibrary.
      * @param speed Movement speed.
-     * @param textureManager Pointer to the TextureManager for loading textures.
-     * @param sdlRenderer SDL_Renderer pointer for rendering.
      */
-    NPC(float x, float y, float width, float height, const std::unordered_map<AnimState, std::string>& textures, float speed, TextureManager* textureManager, SDL_Renderer* sdlRenderer);
+    NPC(float x, float y, float width, float height, AnimationSetRef animation, float speed);
 
     /**
      * @brief Updates the NPC's logic each frame.
@@ -0,0 +1,198 @@
+#ifndef OBJECTPOOL_HPP
+#define OBJECTPOOL_HPP
+
+#include <SDL3/SDL.h>
+#include <new>
+#include <utility>
+#include <vector>
+#include "Arena.hpp"
+
+/**
+ * @struct PoolHandle
+ * @brief Stable reference to an object in an ObjectPool.
+ *
+ * The generation changes whenever a slot is freed, so a handle to a destroyed object stays
+ * detectably stale even after its slot is reused.
+ */
+struct PoolHandle
+{
+    Uint32 index = 0xFFFFFFFFu;
+    Uint32 generation = 0;
+};
+
+/**
+ * @struct PoolStats
+ * @brief ObjectPool occupancy and allocation counters.
+ */
+struct PoolStats
+{
+    size_t live = 0;      // Objects currently alive
+    size_t capacity = 0;  // Slots in all blocks
+    size_t blocks = 0;    // Blocks allocated, the only allocations the pool ever makes
+    Uint64 created = 0;   // Create() calls
+    Uint64 destroyed = 0; // Successful Destroy() calls
+    Uint64 reused = 0;    // Create() calls served from the free list
+};
+
+/**
+ * @class ObjectPoolBase
+ * @brief Type-erased interface so pools of different types can be owned and released together.
+ */
+class ObjectPoolBase
+{
+    public:
+        virtual ~ObjectPoolBase() = default;
+
+        /**
+         * @brief Destroys the object a handle refers to; stale handles are ignored.
+         */
+        virtual void Destroy(PoolHandle handle) = 0;
+
+        /**
+         * @brief Gets the pool's counters.
+         */
+        virtual const PoolStats &GetStats() const = 0;
+};
+
+/**
+ * @class ObjectPool
+ * @brief Fixed-address storage for objects of one type with O(1) create and destroy.
+ *
+ * Objects are constructed in slots inside fixed-size blocks, so they never move and pointers
+ * to them stay valid until they are destroyed. Freed slots go on an intrusive free list and
+ * are reused, newest first, before a new block is allocated. Blocks come from an Arena when
+ * one is given (and are then released with it), or from the global allocator otherwise.
+ *
+ * Not thread-safe: create and destroy from one thread at a time.
+ *
+ * @tparam T The object type. Objects of derived types must go in a pool of their own.
+ */
+template <typename T>
+class ObjectPool : public ObjectPoolBase
+{
+    public:
+        /**
+         * @brief Constructs an empty pool.
+         * @param arena Where blocks are allocated, or nullptr for the global allocator.
+         * @param blockSlots Number of objects per block.
+         */
+        explicit ObjectPool(Arena *arena = nullptr, Uint32 blockSlots = 256)
+            : arena(arena), blockSlots(blockSlots)
+        {
+        }
+
+        /**
+         * @brief Destroys every live object and frees blocks not owned by an arena.
+         */
+        ~ObjectPool() override
+        {
+            for (Uint32 index = 0; index < stats.capacity; ++index)
+            {
+                Slot &slot = SlotAt(index);
+                if (slot.live)
+                    slot.Object()->~T();
+            }
+            for (Slot *block : blocks)
+            {
+                for (Uint32 i = 0; i < blockSlots; ++i)
+                    block[i].~Slot();
+                if (!arena)
+                    ::operator delete(block, std::align_val_t(alignof(Slot)));
+            }
+        }
+
+        /**
+         * @brief Constructs an object in a free slot.
+         * @return Handle to the new object.
+         */
+        template <typename... Args>
+        PoolHandle Create(Args&&... args)
+        {
+            if (freeHead == NO_SLOT)
+                Grow();
+            else
+                ++stats.reused;
+            Uint32 index = freeHead;
+            Slot &slot = SlotAt(index);
+            new (slot.storage) T(std::forward<Args>(args)...);
+            freeHead = slot.nextFree;
+            slot.live = true;
+            ++stats.live;
+            ++stats.created;
+            return { index, slot.generation };
+        }
+
+        /**
+         * @brief Destroys an object and puts its slot on the free list.
+         * @param handle Handle from Create(); stale handles are ignored.
+         */
+        void Destroy(PoolHandle handle) override
+        {
+            T *object = Get(handle);
+            if (!object)
+                return;
+            Slot &slot = SlotAt(handle.index);
+            object->~T();
+            slot.live = false;
+            ++slot.generation;
+            slot.nextFree = freeHead;
+            freeHead = handle.index;
+            --stats.live;
+            ++stats.destroyed;
+        }
+
+        /**
+         * @brief Gets the object a handle refers to.
+         * @return The object, or nullptr if the handle is stale or invalid.
+         */
+        T *Get(PoolHandle handle) const
+        {
+            if (handle.index >= stats.capacity)
+                return nullptr;
+            Slot &slot = SlotAt(handle.index);
+            return slot.live && slot.generation == handle.generation ? slot.Object() : nullptr;
+        }
+
+        const PoolStats &GetStats() const override { return stats; }
+
+    private:
+        static constexpr Uint32 NO_SLOT = 0xFFFFFFFFu;
+
+        struct Slot
+        {
+            alignas(T) unsigned char storage[sizeof(T)];
+            Uint32 generation = 0;
+            Uint32 nextFree = NO_SLOT;
+            bool live = false;
+
+            T *Object() { return std::launder(reinterpret_cast<T *>(storage)); }
+        };
+
+        Slot &SlotAt(Uint32 index) const { return blocks[index / blockSlots][index % blockSlots]; }
+
+        /// @brief Allocates one more block and threads its slots onto the free list in order.
+        void Grow()
+        {
+            void *memory = arena ? arena->Allocate(sizeof(Slot) * blockSlots, alignof(Slot))
+                                 : ::operator new(sizeof(Slot) * blockSlots, std::align_val_t(alignof(Slot)));
+            Slot *block = static_cast<Slot *>(memory);
+            Uint32 first = static_cast<Uint32>(stats.capacity);
+            for (Uint32 i = 0; i < blockSlots; ++i)
+            {
+                new (&block[i]) Slot;
+                block[i].nextFree = i + 1 < blockSlots ? first + i + 1 : freeHead;
+            }
+            blocks.push_back(block);
+            freeHead = first;
+            stats.capacity += blockSlots;
+            ++stats.blocks;
+        }
+
+        Arena *arena;
+        Uint32 blockSlots;
+        std::vector<Slot *> blocks;
+        Uint32 freeHead = NO_SLOT;
+        PoolStats stats;
+};
+
+#endif // OBJECTPOOL_HPP
@@ -4,8 +4,6 @@
 
 #include "GameObject.hpp"
 #include "InputManager.hpp"
-#include <unordered_map>
-#include <string>
 #include <SDL3/SDL.h>
 
 /**
@@ -13,33 +11,29 @@
  * @brief Represents the player character in the game, handling movement, input, and animation.
  *
  * The Player class inherits from GameObject and encapsulates logic for player-specific behavior,
- * including movement, input handling, and animation state management. It utilizes a TextureManager
- * for loading and managing textures, and interacts with an InputManager for processing user input.
+ * including movement, input handling, and animation state management. It plays clips from a shared
+ * AnimationSet, and moves according to the InputManager's per-frame input snapshot.
  *
  * Key Features:
- * - Construction with initial position, animation textures, speed, and rendering context.
+ * - Construction with initial position, size and animation set.
  * - Per-frame update logic for movement and state.
  * - Input handling for responsive player control.
- * - Animation state updates based on movement and facing direction.
  * - Getters and setters for movement speed.
  *
  * @see GameObject
- * @see TextureManager
+ * @see AnimationSet
  * @see InputManager
  */
 class Player : public GameObject 
 {
     public:
         /**
-         * @brief Constructs a Player object at the specified position, loads its textures, and sets speed.
+         * @brief Constructs a Player object at the specified position with the default speed.
          * @param x Initial x-coordinate.
          * @param y Initial y-coordinate.
-         * @param texturePaths Map of animation states to texture file paths.
-         * @param speed Movement speed in pixels per second.
-         * @param textureManager Pointer to the TextureManager.
-         * @param renderer SDL_Renderer to use for loading textures.
+         * @param animation Shared clips to play, from AnimationLibrary.
          */
-        Player(float x, float y, float width, float height, const std::unordered_map<AnimState, std::string>& texturePaths, TextureManager* textureManager, SDL_Renderer* renderer);
+        Player(float x, float y, float width, float height, AnimationSetRef animation);
 
         /**
          * @brief Virtual destructor for safe polymorphic deletion.
@@ -55,29 +49,16 @@ class Player : public GameObject
          * @param dt The time elapsed since the last update (delta time), in seconds.
          */
         void Update(float dt) override;
-        
+
         /**
          * @brief Handles player input and updates player state accordingly.
          * 
-         * Processes input events using the provided InputManager and updates the player's
-         * state based on the elapsed time since the last update.
+         * Reads the frame's input snapshot, which stays unchanged while the scene updates, so
+         * players can update on worker threads like other objects.
          * 
-         * @param input Reference to the InputManager handling user input.
-         * @param dt Delta time in seconds since the last frame.
-         */
-        void HandleInput(InputManager& input, float dt);
-
-        /**
-         * @brief Updates the player's animation state.
-         *
-         * This function updates the animation based on the elapsed time, movement state,
-         * and the direction the player is facing.
-         *
-         * @param dt The time elapsed since the last update (in seconds).
-         * @param moving Indicates whether the player is currently moving.
-         * @param facingRight Indicates whether the player is facing to the right.
+         * @param input The input snapshot for this frame.
          */
-        void UpdateAnim(float dt, bool moving, bool facingRight) override;
+        void HandleInput(const InputSnapshot& input);
 
         /**
          * @brief Sets the player's movement speed.
@@ -0,0 +1,116 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <fstream>
+
+Profiler& Profiler::Instance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler()
+    : origin(SDL_GetPerformanceCounter()), ticksToMs(1000.0 / SDL_GetPerformanceFrequency()), frameHistory(HISTORY_SIZE, 0.0f)
+{
+    frameStartTicks = origin;
+}
+
+Profiler::ThreadBuffer &Profiler::GetThreadBuffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        auto created = std::make_unique<ThreadBuffer>();
+        created->threadIndex = static_cast<Uint32>(buffers.size());
+        created->events.resize(RING_SIZE);
+        buffer = created.get();
+        buffers.push_back(std::move(created));
+    }
+    return *buffer;
+}
+
+void Profiler::EndFrame()
+{
+    if (!mainBuffer)
+        mainBuffer = &GetThreadBuffer();
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    frameHistory[historyNext] = static_cast<float>((now - frameStartTicks) * ticksToMs);
+    historyNext = (historyNext + 1) % HISTORY_SIZE;
+    historyCount = historyCount < HISTORY_SIZE ? historyCount + 1 : HISTORY_SIZE;
+    frameStartTicks = now;
+
+    // Sum this frame's main-thread zones by name (names are literals, so compare pointers)
+    lastFrameZones.clear();
+    Uint64 first = frameStartEvent;
+    if (mainBuffer->written - first > RING_SIZE)
+        first = mainBuffer->written - RING_SIZE;
+    for (Uint64 i = first; i < mainBuffer->written; ++i)
+    {
+        const ProfileEvent &e = mainBuffer->events[i % RING_SIZE];
+        ZoneStat *stat = nullptr;
+        for (ZoneStat &s : lastFrameZones)
+        {
+            if (s.name == e.name)
+            {
+                stat = &s;
+                break;
+            }
+        }
+        if (!stat)
+        {
+            lastFrameZones.push_back({ e.name, e.depth, 0, 0.0, e.start });
+            stat = &lastFrameZones.back();
+        }
+        if (e.start < stat->firstStart)
+        {
+            stat->firstStart = e.start;
+            stat->depth = e.depth;
+        }
+        ++stat->calls;
+        stat->totalMs += (e.end - e.start) * ticksToMs;
+    }
+    frameStartEvent = mainBuffer->written;
+
+    // Events are recorded when zones close (children first), so restore entry order
+    std::sort(lastFrameZones.begin(), lastFrameZones.end(), [](const ZoneStat &a, const ZoneStat &b) { return a.firstStart < b.firstStart; });
+}
+
+const std::vector<ZoneStat> &Profiler::GetLastFrameZones() const { return lastFrameZones; }
+
+std::vector<float> Profiler::GetFrameHistory() const
+{
+    std::vector<float> history;
+    history.reserve(historyCount);
+    for (size_t k = 0; k < historyCount; ++k)
+        history.push_back(frameHistory[(historyNext + HISTORY_SIZE - historyCount + k) % HISTORY_SIZE]);
+    return history;
+}
+
+bool Profiler::ExportChromeTrace(const std::string &path)
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+
+    // "X" (complete) events with microsecond timestamps, one trace thread per profiler thread
+    const double ticksToUs = ticksToMs * 1000.0;
+    bool firstEvent = true;
+    out << "{\"traceEvents\":[\n";
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (const auto &buffer : buffers)
+    {
+        Uint64 first = buffer->written > RING_SIZE ? buffer->written - RING_SIZE : 0;
+        for (Uint64 i = first; i < buffer->written; ++i)
+        {
+            const ProfileEvent &e = buffer->events[i % RING_SIZE];
+            out << (firstEvent ? "" : ",\n")
+                << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->threadIndex
+                << ",\"ts\":" << (e.start - origin) * ticksToUs
+                << ",\"dur\":" << (e.end - e.start) * ticksToUs << "}";
+            firstEvent = false;
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return static_cast<bool>(out);
+}
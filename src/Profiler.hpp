@@ -0,0 +1,169 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <SDL3/SDL.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Scoped-zone profiler.
+ *
+ * Wrap a block in PROFILE_ZONE("Name") to time it; the zone ends when the block does.
+ * Zones nest, may be used from any thread, and are recorded into a fixed-size ring buffer
+ * per thread, so recording never allocates or locks after a thread's first zone.
+ *
+ * When ARROW2D_PROFILING is 0 (see the CMake option of the same name) the macros expand to
+ * nothing and instrumented code pays no cost at all.
+ */
+
+#ifndef ARROW2D_PROFILING
+#define ARROW2D_PROFILING 0
+#endif
+
+/**
+ * @struct ProfileEvent
+ * @brief One completed zone.
+ */
+struct ProfileEvent
+{
+    const char *name; // Zone name; must be a string with static lifetime (normally a literal)
+    Uint64 start;     // Performance counter at zone entry
+    Uint64 end;       // Performance counter at zone exit
+    Uint32 depth;     // Nesting depth on its thread, 0 for outermost zones
+};
+
+/**
+ * @struct ZoneStat
+ * @brief Time spent in one zone name during a frame.
+ */
+struct ZoneStat
+{
+    const char *name;
+    Uint32 depth;      // Depth of the first occurrence, for indenting
+    Uint32 calls;      // Number of times the zone was entered
+    double totalMs;    // Summed duration
+    Uint64 firstStart; // Counter value of the first entry, for ordering
+};
+
+/**
+ * @class Profiler
+ * @brief Singleton that owns the per-thread event buffers and per-frame summaries.
+ *
+ * Usage:
+ *   - Instrument code with PROFILE_ZONE("Name").
+ *   - Call EndFrame() once per frame on the main thread (PROFILE_FRAME_END() does this).
+ *   - Read GetLastFrameZones() and GetFrameHistory() for an on-screen display.
+ *   - Call ExportChromeTrace() to write everything still in the buffers as a trace file
+ *     that chrome://tracing or Perfetto can open.
+ */
+class Profiler
+{
+    public:
+        /// @brief Events kept per thread before the oldest are overwritten.
+        static constexpr size_t RING_SIZE = 1 << 16;
+
+        /// @brief Frames kept in the frame-time history.
+        static constexpr size_t HISTORY_SIZE = 240;
+
+        /// @brief Returns the singleton instance of the Profiler.
+        static Profiler& Instance();
+
+        /// @brief Per-thread ring buffer of completed zones.
+        struct ThreadBuffer
+        {
+            Uint32 threadIndex;
+            Uint32 depth = 0;
+            Uint64 written = 0; // Total events ever recorded; the ring holds the last RING_SIZE
+            std::vector<ProfileEvent> events;
+        };
+
+        /**
+         * @brief Gets the calling thread's buffer, creating it on first use.
+         */
+        ThreadBuffer &GetThreadBuffer();
+
+        /**
+         * @brief Closes the current frame: summarizes the main thread's zones and records the frame time.
+         *
+         * Must be called from the thread that first called it (the main thread).
+         */
+        void EndFrame();
+
+        /**
+         * @brief Gets the per-zone totals of the last completed frame, in first-entered order.
+         */
+        const std::vector<ZoneStat> &GetLastFrameZones() const;
+
+        /**
+         * @brief Gets recent frame times in milliseconds, oldest first.
+         */
+        std::vector<float> GetFrameHistory() const;
+
+        /**
+         * @brief Writes all buffered events in Chrome trace-event JSON format.
+         * @param path Output file path.
+         * @return true if the file was written.
+         */
+        bool ExportChromeTrace(const std::string &path);
+
+    private:
+        Profiler();
+
+        std::mutex buffersMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+        ThreadBuffer *mainBuffer = nullptr;
+        Uint64 frameStartEvent = 0; // mainBuffer->written at the start of the frame
+        Uint64 frameStartTicks = 0;
+        Uint64 origin;              // Counter value trace timestamps are relative to
+        double ticksToMs;
+
+        std::vector<ZoneStat> lastFrameZones;
+        std::vector<float> frameHistory;
+        size_t historyNext = 0;
+        size_t historyCount = 0;
+};
+
+/**
+ * @class ProfileZone
+ * @brief RAII marker that records a zone from construction to destruction.
+ */
+class ProfileZone
+{
+    public:
+        explicit ProfileZone(const char *name)
+            : buffer(Profiler::Instance().GetThreadBuffer()), name(name), depth(buffer.depth++), start(SDL_GetPerformanceCounter())
+        {
+        }
+
+        ~ProfileZone()
+        {
+            Uint64 end = SDL_GetPerformanceCounter();
+            --buffer.depth;
+            buffer.events[buffer.written % Profiler::RING_SIZE] = { name, start, end, depth };
+            ++buffer.written;
+        }
+
+        ProfileZone(const ProfileZone &) = delete;
+        ProfileZone &operator=(const ProfileZone &) = delete;
+
+    private:
+        Profiler::ThreadBuffer &buffer;
+        const char *name;
+        Uint32 depth;
+        Uint64 start;
+};
+
+#if ARROW2D_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define PROFILE_FRAME_END() Profiler::Instance().EndFrame()
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#endif
+
+#endif // PROFILER_HPP
@@ -0,0 +1,170 @@
+#include "ProfilerOverlay.hpp"
+#include "Profiler.hpp"
+#include "GameConfig.hpp"
+#include "TextureManager.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    constexpr float OVERLAY_MARGIN = 8.0f;
+    constexpr float GRAPH_WIDTH = 240.0f;
+    constexpr float GRAPH_HEIGHT = 80.0f;
+    constexpr Uint64 TEXT_REFRESH_NS = 250 * SDL_NS_PER_MS;
+}
+
+bool ProfilerOverlay::Init(const char *fontPath, float pointSize)
+{
+    if (!TTF_Init())
+    {
+        SDL_Log("Failed to initialize SDL_ttf: %s", SDL_GetError());
+        return false;
+    }
+    // Prefer the packed copy; the font reads it straight from the mapped archive
+    const AssetArchive &archive = TextureManager::Instance().GetArchive();
+    if (const ArchiveEntry *packed = archive.Find(fontPath))
+        font = TTF_OpenFontIO(SDL_IOFromConstMem(archive.GetData(*packed), packed->size), true, pointSize);
+    else
+        font = TTF_OpenFont(fontPath, pointSize);
+    if (!font)
+    {
+        SDL_Log("Failed to load overlay font: %s", SDL_GetError());
+        TTF_Quit();
+        return false;
+    }
+    return true;
+}
+
+void ProfilerOverlay::Clean()
+{
+    ClearText();
+    if (font)
+    {
+        TTF_CloseFont(font);
+        font = nullptr;
+        TTF_Quit();
+    }
+}
+
+void ProfilerOverlay::Toggle()
+{
+    visible = !visible;
+    lastTextUpdate = 0; // Refresh immediately when shown
+}
+
+bool ProfilerOverlay::IsVisible() const { return visible; }
+
+void ProfilerOverlay::ClearText()
+{
+    for (TextLine &line : lines)
+        SDL_DestroyTexture(line.texture);
+    lines.clear();
+}
+
+void ProfilerOverlay::RebuildText(SDL_Renderer *renderer)
+{
+    ClearText();
+    const SDL_Color white = { 255, 255, 255, 255 };
+    std::vector<std::string> text;
+
+    std::vector<float> history = Profiler::Instance().GetFrameHistory();
+    if (!history.empty())
+    {
+        float sum = 0.0f;
+        for (float ms : history)
+            sum += ms;
+        float worst = *std::max_element(history.begin(), history.end());
+        char buf[96];
+        std::snprintf(buf, sizeof(buf), "Frame  %.2f ms avg  %.2f ms max", sum / history.size(), worst);
+        text.push_back(buf);
+    }
+    for (const ZoneStat &zone : Profiler::Instance().GetLastFrameZones())
+    {
+        char buf[128];
+        std::snprintf(buf, sizeof(buf), "%*s%s  %.3f ms  x%u", static_cast<int>(zone.depth * 2), "", zone.name, zone.totalMs, zone.calls);
+        text.push_back(buf);
+    }
+
+    for (const std::string &s : text)
+    {
+        SDL_Surface *surface = TTF_RenderText_Blended(font, s.c_str(), s.size(), white);
+        if (!surface)
+            continue;
+        SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+        if (texture)
+            lines.push_back({ texture, static_cast<float>(surface->w), static_cast<float>(surface->h) });
+        SDL_DestroySurface(surface);
+    }
+}
+
+void ProfilerOverlay::RenderGraph(SDL_Renderer *renderer, const SDL_FRect &area)
+{
+    std::vector<float> history = Profiler::Instance().GetFrameHistory();
+
+    // Scale so the frame budget sits at half height, growing if a frame is longer
+    float budgetMs = 1000.0f / FPS_LIMIT;
+    float scaleMs = budgetMs * 2.0f;
+    for (float ms : history)
+        scaleMs = std::max(scaleMs, ms);
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+    SDL_RenderFillRect(renderer, &area);
+
+    float barWidth = area.w / Profiler::HISTORY_SIZE;
+    SDL_SetRenderDrawColor(renderer, 80, 220, 120, 255);
+    for (size_t i = 0; i < history.size(); ++i)
+    {
+        float h = area.h * std::min(1.0f, history[i] / scaleMs);
+        SDL_FRect bar = { area.x + area.w - (history.size() - i) * barWidth, area.y + area.h - h, barWidth, h };
+        SDL_RenderFillRect(renderer, &bar);
+    }
+
+    // Frame budget line
+    float budgetY = area.y + area.h - area.h * (budgetMs / scaleMs);
+    SDL_SetRenderDrawColor(renderer, 230, 80, 80, 255);
+    SDL_RenderLine(renderer, area.x, budgetY, area.x + area.w, budgetY);
+}
+
+void ProfilerOverlay::Render(SDL_Renderer *renderer)
+{
+    if (!visible || !renderer)
+        return;
+
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+    SDL_FRect graph = { OVERLAY_MARGIN, OVERLAY_MARGIN, GRAPH_WIDTH, GRAPH_HEIGHT };
+    RenderGraph(renderer, graph);
+
+    if (font)
+    {
+        Uint64 now = SDL_GetTicksNS();
+        if (lastTextUpdate == 0 || now - lastTextUpdate >= TEXT_REFRESH_NS)
+        {
+            RebuildText(renderer);
+            lastTextUpdate = now;
+        }
+
+        float y = graph.y + graph.h + OVERLAY_MARGIN;
+        float width = GRAPH_WIDTH, height = 0.0f;
+        for (const TextLine &line : lines)
+        {
+            width = std::max(width, line.w);
+            height += line.h;
+        }
+        SDL_FRect panel = { graph.x, y, width + OVERLAY_MARGIN, height + OVERLAY_MARGIN };
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+        SDL_RenderFillRect(renderer, &panel);
+        y += OVERLAY_MARGIN / 2;
+        for (const TextLine &line : lines)
+        {
+            SDL_FRect dest = { graph.x + OVERLAY_MARGIN / 2, y, line.w, line.h };
+            SDL_RenderTexture(renderer, line.texture, nullptr, &dest);
+            y += line.h;
+        }
+    }
+
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+}
@@ -0,0 +1,75 @@
+#ifndef PROFILEROVERLAY_HPP
+#define PROFILEROVERLAY_HPP
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <vector>
+
+/**
+ * @class ProfilerOverlay
+ * @brief Draws a frame-time graph and a per-zone timing table on top of the scene.
+ *
+ * The data comes from the Profiler's frame history and last-frame zone summary. Text is
+ * rendered with SDL3_ttf and only re-rendered a few times per second, so the overlay itself
+ * stays cheap while visible.
+ *
+ * Usage:
+ *   - Call Init() once after the renderer exists, and Clean() before it is destroyed.
+ *   - Call Toggle() to show or hide it.
+ *   - Call Render() after the scene has been drawn (and batched sprites flushed).
+ */
+class ProfilerOverlay
+{
+    public:
+        /**
+         * @brief Loads the font used for the table.
+         * @param fontPath Path to a TrueType font.
+         * @param pointSize Font size in points.
+         * @return true if the font was loaded.
+         */
+        bool Init(const char *fontPath, float pointSize);
+
+        /**
+         * @brief Frees the font and cached text textures.
+         */
+        void Clean();
+
+        /**
+         * @brief Shows the overlay if hidden, hides it if shown.
+         */
+        void Toggle();
+
+        /**
+         * @brief Checks if the overlay is currently shown.
+         */
+        bool IsVisible() const;
+
+        /**
+         * @brief Draws the overlay if it is visible.
+         * @param renderer The renderer to draw with.
+         */
+        void Render(SDL_Renderer *renderer);
+
+    private:
+        /// @brief A rendered line of text.
+        struct TextLine
+        {
+            SDL_Texture *texture;
+            float w, h;
+        };
+
+        /// @brief Re-renders the table text from the profiler's last frame.
+        void RebuildText(SDL_Renderer *renderer);
+
+        /// @brief Destroys the cached text textures.
+        void ClearText();
+
+        void RenderGraph(SDL_Renderer *renderer, const SDL_FRect &area);
+
+        TTF_Font *font = nullptr;
+        bool visible = false;
+        Uint64 lastTextUpdate = 0;
+        std::vector<TextLine> lines;
+};
+
+#endif // PROFILEROVERLAY_HPP
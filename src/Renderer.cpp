@@ -1,5 +1,8 @@
 #include "Renderer.hpp"
+#include "Profiler.hpp"
+#include "TextureManager.hpp"
 #include <SDL3/SDL.h>
+#include <algorithm>
 #include <iostream>
 
 Renderer& Renderer::Instance() 
@@ -8,15 +11,18 @@ Renderer& Renderer::Instance()
     return instance;
 }
 
-bool Renderer::Init(SDL_Window *window)
+bool Renderer::Init(SDL_Window *window, const char *driver)
 {
+    // Queued sprites belong to the old renderer
+    batchSprites.clear();
+    batchLayers.clear();
     if (sdlRenderer)
     {
         SDL_DestroyRenderer(sdlRenderer);
         sdlRenderer = nullptr;
     }
     
-    sdlRenderer = SDL_CreateRenderer(window, NULL);
+    sdlRenderer = SDL_CreateRenderer(window, driver);
     if (!sdlRenderer)
     {
         std::cerr << "Failed to create SDL_Renderer: " << SDL_GetError() << std::endl;
@@ -25,6 +31,27 @@ bool Renderer::Init(SDL_Window *window)
     return true;
 }
 
+bool Renderer::Init(SDL_Renderer *renderer)
+{
+    batchSprites.clear();
+    batchLayers.clear();
+    if (sdlRenderer && sdlRenderer != renderer)
+        SDL_DestroyRenderer(sdlRenderer);
+    sdlRenderer = renderer;
+    return sdlRenderer != nullptr;
+}
+
+void Renderer::Destroy()
+{
+    batchSprites.clear();
+    batchLayers.clear();
+    if (sdlRenderer)
+    {
+        SDL_DestroyRenderer(sdlRenderer);
+        sdlRenderer = nullptr;
+    }
+}
+
 void Renderer::Clean()
 {
     SDL_RenderClear(sdlRenderer);
@@ -36,11 +63,139 @@ void Renderer::Render(GameObject &obj, float offsetX, float offsetY)
     SDL_FRect dest = obj.GetDestRect();
     dest.x -= offsetX;
     dest.y -= offsetY;
-    SDL_RenderTexture(sdlRenderer, obj.GetTexture(), NULL, &dest);
+    RenderTexture(TextureManager::Instance().Resolve(obj.GetTexture()), dest, obj.GetLayer());
+}
+
+void Renderer::RenderTexture(const TextureRegion &region, const SDL_FRect &dest, int layer)
+{
+    if (!region.texture)
+        return;
+    if (!batching)
+    {
+        SDL_RenderTexture(sdlRenderer, region.texture, &region.src, &dest);
+        return;
+    }
+    batchSprites.push_back({region.texture, region.src, dest});
+    batchLayers.push_back(layer);
+}
+
+void Renderer::SetBatching(bool enabled)
+{
+    if (batching && !enabled)
+        Flush();
+    batching = enabled;
+}
+
+bool Renderer::IsBatching() const { return batching; }
+
+void Renderer::ReserveQuadIndices(size_t quads)
+{
+    size_t built = quadIndices.size() / 6;
+    if (built >= quads)
+        return;
+    quadIndices.reserve(quads * 6);
+    for (size_t q = built; q < quads; ++q)
+    {
+        int v = static_cast<int>(q * 4);
+        quadIndices.insert(quadIndices.end(), { v, v + 1, v + 2, v + 2, v + 3, v });
+    }
+}
+
+void Renderer::Flush()
+{
+    PROFILE_ZONE("Renderer::Flush");
+    size_t count = batchSprites.size();
+    if (count == 0)
+        return;
+
+    // Key = layer (16 bits) | texture first-use order (16 bits) | submission index (32 bits).
+    // Every key is unique, so a plain sort gives a deterministic, stable order.
+    batchKeys.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto order = batchTextureOrder.emplace(batchSprites[i].texture, static_cast<Uint32>(batchTextureOrder.size())).first->second;
+        Uint64 layer = static_cast<Uint16>(std::clamp(batchLayers[i], -32768, 32767) + 32768);
+        Uint64 texture = std::min<Uint32>(order, 0xFFFF);
+        batchKeys[i] = (layer << 48) | (texture << 32) | static_cast<Uint32>(i);
+    }
+    std::sort(batchKeys.begin(), batchKeys.end());
+
+    // Build four vertices per sprite in draw order
+    const SDL_FColor white = { 1.0f, 1.0f, 1.0f, 1.0f };
+    batchVertices.resize(count * 4);
+    for (size_t k = 0; k < count; ++k)
+    {
+        const BatchSprite &sprite = batchSprites[static_cast<Uint32>(batchKeys[k])];
+        const SDL_FRect &d = sprite.dest;
+
+        // Source rectangle in pixels to normalized texture coordinates
+        float invW = 1.0f / sprite.texture->w;
+        float invH = 1.0f / sprite.texture->h;
+        float u0 = sprite.src.x * invW, u1 = (sprite.src.x + sprite.src.w) * invW;
+        float v0 = sprite.src.y * invH, v1 = (sprite.src.y + sprite.src.h) * invH;
+
+        SDL_Vertex *v = &batchVertices[k * 4];
+        v[0] = { { d.x,       d.y       }, white, { u0, v0 } };
+        v[1] = { { d.x + d.w, d.y       }, white, { u1, v0 } };
+        v[2] = { { d.x + d.w, d.y + d.h }, white, { u1, v1 } };
+        v[3] = { { d.x,       d.y + d.h }, white, { u0, v1 } };
+    }
+
+    // Draw each run of one texture with a single call
+    size_t runStart = 0;
+    while (runStart < count)
+    {
+        SDL_Texture *texture = batchSprites[static_cast<Uint32>(batchKeys[runStart])].texture;
+        size_t runEnd = runStart + 1;
+        while (runEnd < count && batchSprites[static_cast<Uint32>(batchKeys[runEnd])].texture == texture)
+            ++runEnd;
+        size_t quads = runEnd - runStart;
+        ReserveQuadIndices(quads);
+        SDL_RenderGeometry(sdlRenderer, texture, &batchVertices[runStart * 4], static_cast<int>(quads * 4), quadIndices.data(), static_cast<int>(quads * 6));
+        runStart = runEnd;
+    }
+
+    batchSprites.clear();
+    batchLayers.clear();
+    batchTextureOrder.clear();
+}
+
+SDL_Texture *Renderer::CreateLayerTexture(int width, int height)
+{
+    SDL_Texture *texture = SDL_CreateTexture(sdlRenderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!texture)
+    {
+        std::cerr << "Failed to create layer texture: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return texture;
+}
+
+bool Renderer::BeginLayerBake(SDL_Texture *target)
+{
+    bakeSavedTarget = SDL_GetRenderTarget(sdlRenderer);
+    SDL_Color &c = bakeSavedColor;
+    SDL_GetRenderDrawColor(sdlRenderer, &c.r, &c.g, &c.b, &c.a);
+    if (!SDL_SetRenderTarget(sdlRenderer, target))
+        return false;
+    SDL_SetRenderDrawColor(sdlRenderer, 0, 0, 0, 0);
+    SDL_RenderClear(sdlRenderer);
+    return true;
+}
+
+void Renderer::EndLayerBake()
+{
+    SDL_SetRenderTarget(sdlRenderer, bakeSavedTarget);
+    const SDL_Color &c = bakeSavedColor;
+    SDL_SetRenderDrawColor(sdlRenderer, c.r, c.g, c.b, c.a);
+    bakeSavedTarget = nullptr;
 }
 
 void Renderer::Present()
 {
+    Flush();
+    PROFILE_ZONE("Renderer::Present");
     SDL_RenderPresent(sdlRenderer);
 }
 
@@ -2,7 +2,10 @@
 #define RENDERER_HPP
 
 #include <SDL3/SDL.h>
+#include <unordered_map>
+#include <vector>
 #include "GameObject.hpp"
+#include "TextureRegion.hpp"
 
 /**
  * @class Renderer
@@ -17,6 +20,19 @@
  *   - Use Init() to initialize the renderer with an SDL_Window.
  *   - Use Clean(), Render(), and Present() for the main rendering loop.
  *   - Retrieve the underlying SDL_Renderer pointer with GetSDLRenderer() if needed.
+ *
+ * Sprite batching:
+ *   - When batching is enabled with SetBatching(), sprites passed to Render() and RenderTexture()
+ *     are queued instead of drawn. Flush() (called by Present()) sorts them by layer, groups each
+ *     layer by texture, and draws every run of one texture with a single SDL_RenderGeometry call.
+ *   - Lower layers are drawn first. Within a layer, textures are drawn in the order they were
+ *     first submitted and sprites sharing a texture keep their submission order, so the result is
+ *     deterministic. Sprites that must overlap in a specific order should use different layers.
+ *
+ * Cached layers:
+ *   - Content that rarely changes, such as a StaticLayer or a Tilemap, is drawn once into chunk
+ *     textures and then blitted as one sprite per chunk. CreateLayerTexture() makes such a
+ *     texture, and BeginLayerBake()/EndLayerBake() redirect drawing into it and back.
  */
 class Renderer
 {
@@ -48,10 +64,70 @@ class Renderer
          */
         void Render(GameObject &obj, float offsetX = 0.0f, float offsetY = 0.0f);
 
+        /**
+         * @brief Renders a texture region into a destination rectangle given in screen space.
+         *
+         * Used by loops that iterate entity data directly instead of GameObject instances.
+         * Regions without a texture are skipped. When batching is enabled the sprite is queued
+         * until Flush().
+         *
+         * @param region The atlas texture and source rectangle to draw.
+         * @param dest Destination rectangle, already offset by the camera.
+         * @param layer Draw layer; lower layers are drawn first when batching.
+         */
+        void RenderTexture(const TextureRegion &region, const SDL_FRect &dest, int layer = 0);
+
+        /**
+         * @brief Enables or disables sprite batching.
+         *
+         * Disabling batching flushes any queued sprites first.
+         *
+         * @param enabled True to queue sprites and draw them in batches.
+         */
+        void SetBatching(bool enabled);
+
+        /**
+         * @brief Checks if sprite batching is enabled.
+         */
+        bool IsBatching() const;
+
+        /**
+         * @brief Draws all queued sprites, one SDL_RenderGeometry call per texture run.
+         *
+         * Call this before drawing anything directly through the SDL_Renderer so it ends up
+         * on top of the batched sprites. Does nothing when the queue is empty.
+         */
+        void Flush();
+
+        /**
+         * @brief Creates a transparent texture that layer chunks are baked into.
+         * @param width Width in pixels.
+         * @param height Height in pixels.
+         * @return The texture, owned by the caller, or nullptr on failure (logged).
+         */
+        SDL_Texture *CreateLayerTexture(int width, int height);
+
+        /**
+         * @brief Redirects drawing into @p target and clears it to transparent.
+         *
+         * Draw the chunk's contents with SDL_RenderTexture on GetSDLRenderer(), not RenderTexture(),
+         * which may queue them for the screen. Sprites already queued are unaffected.
+         *
+         * @param target A texture from CreateLayerTexture().
+         * @return true if drawing now goes to @p target; EndLayerBake() must follow either way.
+         */
+        bool BeginLayerBake(SDL_Texture *target);
+
+        /**
+         * @brief Restores the render target and draw color saved by BeginLayerBake().
+         */
+        void EndLayerBake();
+
         /**
          * @brief Presents the current rendering on the screen.
          *
-         * This function updates the window with any rendering performed since the previous call.
+         * This function flushes queued sprites and updates the window with any rendering
+         * performed since the previous call.
          * It wraps SDL_RenderPresent to display the rendered content using the associated SDL renderer.
          */
         void Present();
@@ -70,9 +146,26 @@ class Renderer
          * It must be called before any rendering or texture loading occurs.
          *
          * @param window The SDL_Window to associate with the renderer.
+         * @param driver Name of the render driver to use (e.g. SDL_SOFTWARE_RENDERER), or NULL for the default.
          * @return true if the renderer was created successfully, false otherwise.
          */
-        bool Init(SDL_Window *window);
+        bool Init(SDL_Window *window, const char *driver = NULL);
+
+        /**
+         * @brief Destroys the SDL renderer. Call before destroying the window it renders to.
+         */
+        void Destroy();
+
+        /**
+         * @brief Initializes the renderer from an already created SDL_Renderer.
+         *
+         * Useful for offscreen rendering, e.g. a software renderer drawing into an SDL_Surface.
+         * The Renderer takes ownership and destroys it on the next Init() call.
+         *
+         * @param renderer The SDL_Renderer to use.
+         * @return true if @p renderer is valid, false otherwise.
+         */
+        bool Init(SDL_Renderer *renderer);
 
     private:
         /**
@@ -84,7 +177,37 @@ class Renderer
 
         /// Pointer to the SDL_Renderer used for rendering graphics to the window.
         /// This renderer is responsible for all 2D drawing operations in the application.
-        SDL_Renderer *sdlRenderer;
+        SDL_Renderer *sdlRenderer = nullptr;
+
+        /// @brief A queued sprite waiting for the next Flush().
+        struct BatchSprite
+        {
+            SDL_Texture *texture;
+            SDL_FRect src;
+            SDL_FRect dest;
+        };
+
+        /// @brief Grows the shared quad index buffer to cover at least @p quads quads.
+        void ReserveQuadIndices(size_t quads);
+
+        bool batching = false;
+        std::vector<BatchSprite> batchSprites;
+        std::vector<int> batchLayers;
+
+        /// @brief Sort keys: layer, texture order and submission order packed into 64 bits.
+        std::vector<Uint64> batchKeys;
+
+        /// @brief Order in which each texture was first submitted this batch.
+        std::unordered_map<SDL_Texture *, Uint32> batchTextureOrder;
+
+        std::vector<SDL_Vertex> batchVertices;
+
+        /// @brief State saved by BeginLayerBake() for EndLayerBake() to restore.
+        SDL_Texture *bakeSavedTarget = nullptr;
+        SDL_Color bakeSavedColor = { 0, 0, 0, 255 };
+
+        /// @brief Indices for consecutive quads (0,1,2, 2,3,0, 4,5,6, ...), built once and reused by every run.
+        std::vector<int> quadIndices;
 };
 
 #endif // RENDERER_HPP
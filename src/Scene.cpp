@@ -2,101 +2,389 @@
 #include "Player.hpp"
 #include "Renderer.hpp"
 #include "GameConfig.hpp"
+#include "Profiler.hpp"
+#include "JobSystem.hpp"
+#include "TextureManager.hpp"
+#include <algorithm>
+#include <cmath>
+
+Scene::Scene()
+    : grid(COLLISION_CELL_SIZE), arena(SCENE_ARENA_BLOCK_BYTES)
+{
+}
 
 void Scene::AddObject(GameObject* obj)
 {
     // Add a new game object to the scene (Scene takes ownership)
-    objects.push_back(obj);
+    Adopt(obj, nullptr, {});
+}
+
+void Scene::Adopt(GameObject* obj, ObjectPoolBase* pool, PoolHandle handle)
+{
+    if (!player && dynamic_cast<class Player*>(obj))
+        player = obj; // Camera target (assumes only one Player in the scene)
+    obj->AttachToStore(&entities);
+    EntityId id = obj->GetEntityId();
+    if (spawnBatch)
+        batchIds.push_back(id);
+    else
+    {
+        entities.gridRect[entities.IndexOf(id)] = obj->GetHitbox();
+        grid.Insert(id, obj->GetHitbox());
+    }
+    if (id >= ownership.size())
+        ownership.resize(id + 1);
+    ownership[id] = { pool, handle };
+}
+
+void Scene::BeginSpawnBatch(size_t count)
+{
+    entities.Reserve(entities.Size() + count);
+    ownership.reserve(ownership.size() + count);
+    batchIds.reserve(count);
+    spawnBatch = true;
+}
+
+void Scene::EndSpawnBatch()
+{
+    std::vector<SDL_FRect> rects(batchIds.size());
+    for (size_t i = 0; i < batchIds.size(); ++i)
+    {
+        size_t index = entities.IndexOf(batchIds[i]);
+        rects[i] = entities.hitbox[index];
+        entities.gridRect[index] = rects[i];
+    }
+    grid.InsertMany(batchIds.data(), rects.data(), batchIds.size());
+    batchIds.clear();
+    batchIds.shrink_to_fit();
+    spawnBatch = false;
+}
+
+void Scene::Despawn(GameObject* obj)
+{
+    EntityId id = obj->GetEntityId();
+    if (!entities.IsValid(id) || entities.owner[entities.IndexOf(id)] != obj)
+        return;
+    grid.Remove(id, entities.gridRect[entities.IndexOf(id)]);
+    if (player == obj)
+        player = nullptr;
+    obj->DetachFromStore();
+    Ownership owner = ownership[id];
+    ownership[id] = {};
+    if (owner.pool)
+        owner.pool->Destroy(owner.handle);
+    else
+        delete obj;
+}
+
+Scene::AllocationStats Scene::GetAllocationStats() const
+{
+    AllocationStats stats;
+    for (const auto& [type, pool] : pools)
+    {
+        const PoolStats& p = pool->GetStats();
+        stats.pools.live += p.live;
+        stats.pools.capacity += p.capacity;
+        stats.pools.blocks += p.blocks;
+        stats.pools.created += p.created;
+        stats.pools.destroyed += p.destroyed;
+        stats.pools.reused += p.reused;
+    }
+    stats.poolTypes = pools.size();
+    stats.arena = arena.GetStats();
+    return stats;
+}
+
+Arena& Scene::GetArena() { return arena; }
+
+bool Scene::LoadTilemap(const std::string& path) { return tilemap.Load(path); }
+
+Tilemap& Scene::GetTilemap() { return tilemap; }
+
+bool Scene::LoadWorld(const std::string& path)
+{
+    world.Clear(*this);
+    return world.Load(path);
+}
+
+WorldStreamer& Scene::GetWorld() { return world; }
+
+StaticLayer& Scene::GetStaticLayer(int drawLayer)
+{
+    std::unique_ptr<StaticLayer>& layer = staticLayers[drawLayer];
+    if (!layer)
+        layer = std::make_unique<StaticLayer>(drawLayer);
+    return *layer;
 }
 
 void Scene::Update(float dt)
 {
-    // Update all game objects in the scene with per-axis collision checks
-    for (auto obj : objects) 
+    PROFILE_ZONE("Scene::Update");
+    // Movement runs as phases over the whole store. Each phase reads only state the previous
+    // phases finished, so the result is the same whatever the thread count or batch order.
+    EntityStore& e = entities;
+    JobSystem& jobs = JobSystem::Instance();
+    const size_t count = e.Size();
+
+    // Remember where this step started so Render() can interpolate
+    e.prevX = e.x;
+    e.prevY = e.y;
+
+    // Refile objects moved through their setters since the last step, so the grid matches
+    // the hitboxes the phases below start from
+    for (size_t i = 0; i < count; ++i)
     {
-        // Check X movement
-        float tryX = obj->GetX() + obj->GetVX() * dt;
-        SDL_FRect hitboxX = obj->GetHitbox();
-        hitboxX.x = tryX;
-        bool collisionX = false;
-        for (auto other : objects) 
+        const SDL_FRect& h = e.hitbox[i];
+        SDL_FRect& filed = e.gridRect[i];
+        if (h.x != filed.x || h.y != filed.y || h.w != filed.w || h.h != filed.h)
         {
-            if (other == obj) 
-                continue;
-            if (GameObject::Intersects(hitboxX, other->GetHitbox())) 
+            grid.Move(e.ids[i], filed, h);
+            filed = h;
+        }
+    }
+
+    // Phase 1: intended moves, and the box each entity sweeps if its move is accepted
+    targetX.resize(count);
+    targetY.resize(count);
+    swept.resize(count);
+    {
+        PROFILE_ZONE("Scene::Intend");
+        jobs.ParallelFor(count, JOB_MIN_BATCH, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
             {
-                collisionX = true;
-                break;
+                targetX[i] = e.x[i] + e.vx[i] * dt;
+                targetY[i] = e.y[i] + e.vy[i] * dt;
+                const SDL_FRect& h = e.hitbox[i];
+                float x0 = std::min(h.x, targetX[i]), y0 = std::min(h.y, targetY[i]);
+                swept[i] = { x0, y0, std::max(h.x, targetX[i]) + h.w - x0, std::max(h.y, targetY[i]) + h.h - y0 };
             }
-        }
-        if (!collisionX)
-            obj->SetX(tryX);
-
-        // Check Y movement
-        float tryY = obj->GetY() + obj->GetVY() * dt;
-        SDL_FRect hitboxY = obj->GetHitbox();
-        hitboxY.y = tryY;
-        bool collisionY = false;
-        for (auto other : objects) 
+        });
+    }
+    float reach = 0.0f; // Furthest any swept box extends past its hitbox
+    for (size_t i = 0; i < count; ++i)
+        reach = std::max(reach, std::max(std::fabs(e.vx[i]), std::fabs(e.vy[i])) * dt);
+
+    // Phase 2: continuous collision against the grid as it was at the start of the step. Each
+    // entity sweeps its hitbox along its whole move, so fast movers cannot skip over thin
+    // obstacles. On contact it stops at the obstacle's face and slides the rest of the way along
+    // it, once. Obstacles are the other entities' swept boxes, which keeps two entities from
+    // moving into the same space in one step; a check against their old positions alone would
+    // allow it. Ties between obstacles hit at the same time go to the lower entity ID, so the
+    // result does not depend on the order the grid returns them in. Solid tiles of the scene's
+    // tilemap are obstacles too.
+    resolvedX.resize(count);
+    resolvedY.resize(count);
+    {
+        PROFILE_ZONE("Scene::Resolve");
+        jobs.ParallelFor(count, JOB_MIN_BATCH, [&](size_t begin, size_t end)
         {
-            if (other == obj) continue;
-            if (GameObject::Intersects(hitboxY, other->GetHitbox())) 
+            for (size_t i = begin; i < end; ++i)
             {
-                collisionY = true;
-                break;
+                SDL_FRect box = e.hitbox[i];
+                float dx = targetX[i] - e.x[i];
+                float dy = targetY[i] - e.y[i];
+                for (int pass = 0; pass < 2 && (dx != 0.0f || dy != 0.0f); ++pass)
+                {
+                    SweepHit first;
+                    SDL_FRect firstRect = {};
+                    EntityId firstId = INVALID_ENTITY;
+                    grid.ForEachNear(swept[i], reach, [&](EntityId id)
+                    {
+                        if (id == e.ids[i])
+                            return;
+                        const SDL_FRect& other = swept[e.IndexOf(id)];
+                        SweepHit hit = GameObject::Sweep(box, dx, dy, other);
+                        if (hit.Hit() && (hit.time < first.time || (hit.time == first.time && id < firstId)))
+                        {
+                            first = hit;
+                            firstRect = other;
+                            firstId = id;
+                        }
+                    });
+                    // Level geometry: one bit test per tile the path covers. Entities win ties.
+                    SDL_FRect path = { std::min(box.x, box.x + dx), std::min(box.y, box.y + dy), box.w + std::fabs(dx), box.h + std::fabs(dy) };
+                    tilemap.ForEachSolidTile(path, [&](const SDL_FRect& tile)
+                    {
+                        SweepHit hit = GameObject::Sweep(box, dx, dy, tile);
+                        if (hit.Hit() && hit.time < first.time)
+                        {
+                            first = hit;
+                            firstRect = tile;
+                            firstId = INVALID_ENTITY;
+                        }
+                    });
+
+                    box.x += dx * first.time;
+                    box.y += dy * first.time;
+                    if (!first.Hit())
+                        break;
+                    if (first.time > 0.0f)
+                    {
+                        // Land exactly on the face so rounding never leaves the boxes overlapping
+                        if (first.normalX != 0.0f)
+                            box.x = first.normalX < 0.0f ? firstRect.x - box.w : firstRect.x + firstRect.w;
+                        else
+                            box.y = first.normalY < 0.0f ? firstRect.y - box.h : firstRect.y + firstRect.h;
+                    }
+                    // Slide: keep the rest of the move along the face
+                    float rest = 1.0f - first.time;
+                    dx = first.normalX != 0.0f ? 0.0f : dx * rest;
+                    dy = first.normalY != 0.0f ? 0.0f : dy * rest;
+                }
+                resolvedX[i] = box.x; // Commit keeps the hitbox at the entity's position
+                resolvedY[i] = box.y;
             }
+        });
+    }
+
+    // Phase 3: commit positions and hitboxes, and move the entities in the grid
+    {
+        PROFILE_ZONE("Scene::Commit");
+        for (size_t i = 0; i < count; ++i)
+        {
+            e.x[i] = resolvedX[i];
+            e.y[i] = resolvedY[i];
+            SDL_FRect newHitbox = e.hitbox[i];
+            newHitbox.x = e.x[i];
+            newHitbox.y = e.y[i];
+            e.hitbox[i] = newHitbox;
+            grid.Move(e.ids[i], e.gridRect[i], newHitbox);
+            e.gridRect[i] = newHitbox;
         }
-        if (!collisionY)
-            obj->SetY(tryY);
+    }
 
-        // Update hitbox to new position
-        SDL_FRect newHitbox = obj->GetHitbox();
-        newHitbox.x = obj->GetX();
-        newHitbox.y = obj->GetY();
-        obj->SetHitbox(newHitbox);
+    // Phase 4: per-object logic. Objects that read shared systems run
+    // afterwards on this thread, in storage order.
+    {
+        PROFILE_ZONE("Scene::Behave");
+        jobs.ParallelFor(count, JOB_MIN_BATCH, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                if (!e.owner[i]->RequiresMainThread())
+                    e.owner[i]->Update(dt);
+            }
+        });
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (e.owner[i]->RequiresMainThread())
+                e.owner[i]->Update(dt);
+        }
+    }
 
-        obj->Update(dt); // update everything else (including animation)
+    // Stream the world around where the player was simulated to, not where it is drawn, so the
+    // regions loaded on each step do not depend on the frame rate
+    if (!world.IsEmpty() && player)
+    {
+        size_t p = e.IndexOf(player->GetEntityId());
+        SDL_FRect view = { e.x[p] - (WINDOW_WIDTH / 2.0f) + (PLAYER_HOR_SIZE / 2.0f), e.y[p] - (WINDOW_HEIGHT / 2.0f) + (PLAYER_VER_SIZE / 2.0f),
+                           static_cast<float>(WINDOW_WIDTH), static_cast<float>(WINDOW_HEIGHT) };
+        world.Stream(*this, view);
     }
 }
 
 void Scene::UpdateAnim(float dt)
 {
-    // Update animation state for all game objects
-    for (auto obj : objects)
-        obj->UpdateAnim(dt, obj->GetVX() != 0.0f || obj->GetVY() != 0.0f, obj->GetVX() >= 0.0f);
+    PROFILE_ZONE("Scene::UpdateAnim");
+    animator.Update(entities, dt);
 }
 
-void Scene::Render(Renderer& renderer)
+const std::vector<AnimationEvent>& Scene::GetAnimationEvents() const { return animator.GetEvents(); }
+
+void Scene::Render(Renderer& renderer, float alpha)
 {
-    // Find the player (assumes only one Player in objects)
-    GameObject* player = nullptr;
-    for (auto obj : objects) 
+    PROFILE_ZONE("Scene::Render");
+    float offsetX = 0.0f, offsetY = 0.0f;
+    int winW = 960, winH = 540; // Default fallback
+    SDL_Renderer* sdlRenderer = renderer.GetSDLRenderer();
+    if (sdlRenderer) 
+        SDL_GetCurrentRenderOutputSize(sdlRenderer, &winW, &winH);
+    if (player) 
+    {
+        // Center the player in the window
+        size_t p = entities.IndexOf(player->GetEntityId());
+        float playerX = entities.prevX[p] + (entities.x[p] - entities.prevX[p]) * alpha;
+        float playerY = entities.prevY[p] + (entities.y[p] - entities.prevY[p]) * alpha;
+        offsetX = playerX - (winW / 2.0f) + (PLAYER_HOR_SIZE / 2.0f);
+        offsetY = playerY - (winH / 2.0f) + (PLAYER_VER_SIZE / 2.0f);
+    }
+
+    // Find candidates through the collision grid. Sprites may be larger than their hitboxes
+    // and are drawn up to one step behind them, so the query is widened by a margin and the
+    // exact test uses the interpolated sprite rectangle.
+    SDL_FRect camera = { offsetX, offsetY, static_cast<float>(winW), static_cast<float>(winH) };
+    SDL_FRect query = { camera.x - CULL_MARGIN, camera.y - CULL_MARGIN, camera.w + 2 * CULL_MARGIN, camera.h + 2 * CULL_MARGIN };
+    const EntityStore& e = entities;
+    {
+        PROFILE_ZONE("Scene::Cull");
+        visibleIds.clear();
+        grid.Query(query, visibleIds);
+
+        // Draw in storage order so culling never changes the submission order
+        visibleIndices.clear();
+        for (EntityId id : visibleIds)
+            visibleIndices.push_back(static_cast<Uint32>(e.IndexOf(id)));
+        std::sort(visibleIndices.begin(), visibleIndices.end());
+    }
+
+    // Level geometry and scenery: one blit per visible chunk, ordered by their draw layers
+    tilemap.Render(renderer, camera);
+    for (auto& [drawLayer, layer] : staticLayers)
+        layer->Render(renderer, camera);
+
+    // Render visible entities with camera offset
+    const TextureManager& textures = TextureManager::Instance();
+    renderStats.drawn = 0;
+    renderStats.culled = e.Size() - visibleIndices.size();
+    for (Uint32 i : visibleIndices)
     {
-        if (dynamic_cast<class Player*>(obj)) 
+        float x = e.prevX[i] + (e.x[i] - e.prevX[i]) * alpha;
+        float y = e.prevY[i] + (e.y[i] - e.prevY[i]) * alpha;
+        SDL_FRect sprite = { x, y, e.width[i], e.height[i] };
+        if (!GameObject::Intersects(sprite, camera))
         {
-            player = obj;
-            break;
+            ++renderStats.culled;
+            continue;
         }
+        SDL_FRect dest = { sprite.x - offsetX, sprite.y - offsetY, sprite.w, sprite.h };
+        const AnimationSet *animation = e.animation[i];
+        if (!animation)
+            continue;
+        renderer.RenderTexture(textures.Resolve(animation->GetFrameTexture(e.animState[i], e.animFrame[i])), dest, e.layer[i]);
+        ++renderStats.drawn;
     }
-    float offsetX = 0.0f, offsetY = 0.0f;
-    if (player) 
+}
+
+Uint64 Scene::GetStateChecksum() const
+{
+    // FNV-1a over the raw bits, in storage order
+    Uint64 hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size)
     {
-        // Center the player in the window
-        int winW = 960, winH = 540; // Default fallback
-        SDL_Renderer* sdlRenderer = renderer.GetSDLRenderer();
-        if (sdlRenderer) 
-            SDL_GetCurrentRenderOutputSize(sdlRenderer, &winW, &winH);
-        offsetX = player->GetX() - (winW / 2.0f) + (PLAYER_HOR_SIZE / 2.0f);
-        offsetY = player->GetY() - (winH / 2.0f) + (PLAYER_VER_SIZE / 2.0f);
+        const Uint8* bytes = static_cast<const Uint8*>(data);
+        for (size_t i = 0; i < size; ++i)
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+    };
+    const EntityStore& e = entities;
+    for (size_t i = 0; i < e.Size(); ++i)
+    {
+        mix(&e.ids[i], sizeof(e.ids[i]));
+        mix(&e.x[i], sizeof(float));
+        mix(&e.y[i], sizeof(float));
+        mix(&e.vx[i], sizeof(float));
+        mix(&e.vy[i], sizeof(float));
+        mix(&e.animState[i], sizeof(e.animState[i]));
+        mix(&e.animFrame[i], sizeof(e.animFrame[i]));
     }
-    // Render all game objects with camera offset
-    for (auto obj : objects)
-        renderer.Render(*obj, offsetX, offsetY);
+    return hash;
 }
 
+const Scene::RenderStats& Scene::GetRenderStats() const { return renderStats; }
+
 Scene::~Scene()
 {
-    // Delete all owned game objects
-    for (auto obj : objects)
-        delete obj;
+    // Destroy all owned game objects, last entity first so nothing is swapped around
+    while (entities.Size() > 0)
+        Despawn(entities.owner.back());
 }
@@ -2,9 +2,22 @@
 #ifndef SCENE_HPP
 #define SCENE_HPP
 
+#include <map>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
 #include <vector>
+#include "AnimationSystem.hpp"
+#include "Arena.hpp"
 #include "GameObject.hpp"
 #include "Renderer.hpp"
+#include "SpatialGrid.hpp"
+#include "StaticLayer.hpp"
+#include "EntityStore.hpp"
+#include "GameConfig.hpp"
+#include "ObjectPool.hpp"
+#include "Tilemap.hpp"
+#include "WorldStreamer.hpp"
 
 /**
  * @class Scene
@@ -16,21 +29,155 @@
  * add objects, update their state, update their animations, and render them
  * using a provided Renderer.
  *
- * @note The Scene class deletes all owned game objects upon destruction.
+ * The hot per-object state (position, velocity, hitbox and animation cursor) is kept
+ * in an EntityStore, and Update(), UpdateAnim() and Render() iterate its arrays directly.
+ * The GameObject instances act as views onto their entities and supply per-object behavior.
+ *
+ * Objects created with Spawn() live in per-type ObjectPools whose blocks, like the pools
+ * themselves, come from the scene's Arena, so spawning and despawning churns no global
+ * allocations once the pools have grown. Objects given to AddObject() are heap allocated by
+ * the caller and deleted by the scene.
+ *
+ * Walls and other level geometry belong in the scene's Tilemap rather than in objects: its
+ * solid tiles block movement at the cost of a bit test per tile a mover's path touches.
+ *
+ * Worlds too large to create up front are split into regions that a WorldStreamer loads around
+ * the camera and removes behind it at the end of Update(); see LoadWorld().
+ *
+ * @note The Scene class destroys all owned game objects upon destruction.
  */
 class Scene
 {
     public:
+        /**
+         * @brief Constructs an empty scene with a collision grid sized from GameConfig.
+         */
+        Scene();
+
         /**
          * @brief Adds a game object to the scene.
          *
          * This function takes a pointer to a GameObject and adds it to the scene's collection
          * of objects. The scene takes ownership of the object and is responsible for managing
-         * its lifetime.
+         * its lifetime. The object's state is moved into the scene's entity store and its current
+         * hitbox is registered with the collision grid, so it should be fully positioned before
+         * being added.
          *
          * @param obj Pointer to the GameObject to be added to the scene.
          */
         void AddObject(GameObject* obj);
+
+        /**
+         * @brief Constructs an object in the scene's pool for its type and adds it to the scene.
+         *
+         * Costs O(1): the slot comes from the pool's free list and the scene's arena supplies new
+         * blocks when the pool is full. The object never moves, so the returned pointer stays valid
+         * until the object is despawned. Like AddObject(), call it from the main thread outside
+         * Update().
+         *
+         * @tparam T The object type, a GameObject.
+         * @param args Constructor arguments.
+         * @return The new object, owned by the scene.
+         */
+        template <typename T, typename... Args>
+        T* Spawn(Args&&... args)
+        {
+            ObjectPool<T>& pool = GetPool<T>();
+            PoolHandle handle = pool.Create(std::forward<Args>(args)...);
+            T* obj = pool.Get(handle);
+            Adopt(obj, &pool, handle);
+            return obj;
+        }
+
+        /**
+         * @brief Starts adding many objects at once, e.g. from a scene file.
+         *
+         * Makes room for @p count more objects, and until EndSpawnBatch() new objects join the
+         * collision grid in one pass at the end instead of one at a time. Do not despawn or
+         * update objects before the batch ends.
+         *
+         * @param count Number of objects about to be added.
+         */
+        void BeginSpawnBatch(size_t count);
+
+        /**
+         * @brief Adds the objects spawned since BeginSpawnBatch() to the collision grid.
+         */
+        void EndSpawnBatch();
+
+        /**
+         * @brief Removes an object from the scene and destroys it in O(1).
+         *
+         * Spawned objects return their slot to their pool; objects given to AddObject() are deleted.
+         * Objects not in this scene are ignored. Call it from the main thread outside Update().
+         *
+         * @param obj The object to remove.
+         */
+        void Despawn(GameObject* obj);
+
+        /// @brief Allocation counters of the scene's pools and arena.
+        struct AllocationStats
+        {
+            PoolStats pools; // Summed over every pool
+            size_t poolTypes = 0; // Number of pools (one per spawned type)
+            ArenaStats arena;
+        };
+
+        /**
+         * @brief Gets the allocation counters of the scene's pools and arena.
+         */
+        AllocationStats GetAllocationStats() const;
+
+        /**
+         * @brief Gets the scene's arena, for data that lives as long as the scene.
+         */
+        Arena& GetArena();
+
+        /**
+         * @brief Loads the scene's level geometry, replacing any previous tilemap.
+         *
+         * Solid tiles block every object's movement in Update(), and the map is drawn beneath
+         * the objects in Render().
+         *
+         * @param path Path of the map file.
+         * @return true if the map was loaded.
+         */
+        bool LoadTilemap(const std::string& path);
+
+        /**
+         * @brief Gets the scene's tilemap, for building or editing levels in code.
+         */
+        Tilemap& GetTilemap();
+
+        /**
+         * @brief Streams the regions of a world around the camera, replacing any previous world.
+         *
+         * Regions near the player's view are read in the background and their objects created over
+         * the following steps; regions far from it are removed. Both happen at the end of Update(),
+         * around the simulated player position. Scenes without a player call
+         * GetWorld().Stream() themselves.
+         *
+         * @param path Path of the world file.
+         * @return true if the world file was read.
+         */
+        bool LoadWorld(const std::string& path);
+
+        /**
+         * @brief Gets the scene's world streamer, for its stats or to build a world in code.
+         */
+        WorldStreamer& GetWorld();
+
+        /**
+         * @brief Gets the static layer drawn on a renderer layer, creating it the first time.
+         *
+         * Scenery that does not move, such as props and decals, belongs in a static layer rather
+         * than in objects: it is drawn as one cached texture per visible chunk, so its cost per
+         * frame does not grow with the number of sprites.
+         *
+         * @param drawLayer Renderer layer; objects are on layer 0 unless given another.
+         * @return The layer, which lives as long as the scene.
+         */
+        StaticLayer& GetStaticLayer(int drawLayer);
         
        
         /**
@@ -46,30 +193,67 @@ class Scene
          * This function should be called once per frame to advance the simulation,
          * animate objects, process physics, or handle any time-dependent logic.
          *
+         * Movement is split into phases spread across the JobSystem: intended moves, collision
+         * checks against a snapshot of the step's starting state, then a serial commit. Object
+         * Update() calls follow on the workers, except for objects that RequiresMainThread().
+         * The result does not depend on the number of worker threads.
+         *
          * @param dt The time elapsed since the last update call, in seconds.
          */
         void Update(float dt);
 
         
         /**
-         * @brief Updates the animation state of the object.
+         * @brief Advances the animation of every object.
          * 
-         * This function advances the animation based on the elapsed time.
+         * Runs the scene's AnimationSystem over the entity store: states follow each object's
+         * velocity and frames advance at their clips' rates. No per-object virtual calls are made.
          * 
          * @param dt The time delta in seconds since the last update.
          */
         void UpdateAnim(float dt);
+
+        /**
+         * @brief Gets the frame changes produced by the most recent UpdateAnim() call.
+         */
+        const std::vector<AnimationEvent>& GetAnimationEvents() const;
     
         /**
          * @brief Renders the scene using the provided renderer, centering the player.
          *
          * This function draws all scene elements by utilizing the specified Renderer instance.
          * The player is always rendered at the center of the window, and all other objects
-         * are offset accordingly to create a camera-follow effect.
+         * are offset accordingly to create a camera-follow effect. Objects outside the camera
+         * rectangle are culled using the collision grid, so off-screen objects are never visited.
+         *
+         * Positions are interpolated between the start and end of the last Update() step, so
+         * motion stays smooth when the display rate differs from the simulation rate.
          *
          * @param renderer Reference to the Renderer object responsible for drawing the scene.
+         * @param alpha Interpolation factor in [0, 1]; 1 draws the latest simulated positions.
+         */
+        void Render(Renderer& renderer, float alpha = 1.0f);
+
+        /**
+         * @brief Hashes the simulated state of every entity: position, velocity and animation.
+         *
+         * Two runs that simulate the same thing give the same checksum after every Update(),
+         * whatever the thread count, so comparing checksums step by step finds where a replay
+         * first diverged from its recording.
+         */
+        Uint64 GetStateChecksum() const;
+
+        /// @brief Per-frame culling counters filled in by Render().
+        struct RenderStats
+        {
+            size_t drawn = 0;  // Objects submitted to the renderer
+            size_t culled = 0; // Objects skipped because they were outside the camera; objects without animation are neither
+        };
+
+        /**
+         * @brief Gets the culling counters from the most recent Render() call.
          */
-        void Render(Renderer& renderer);
+        const RenderStats& GetRenderStats() const;
     
         /**
          * @brief Virtual destructor for the Scene class.
@@ -79,7 +263,50 @@ class Scene
         virtual ~Scene();
 
     protected:
-        std::vector<GameObject*> objects; // Owned game objects
+        EntityStore entities; // Hot state of every object, iterated by the per-frame loops
+        SpatialGrid grid; // Broadphase over entity hitboxes, kept in sync by Update()
+        GameObject* player = nullptr; // First Player added, followed by the camera
+        Tilemap tilemap; // Static level geometry, drawn below the objects and blocking their movement
+        std::map<int, std::unique_ptr<StaticLayer>> staticLayers; // Cached scenery by renderer layer
+        WorldStreamer world; // Regions loaded around the camera, empty unless LoadWorld() is used
+
+    private:
+        /// @brief Who owns an entity's object: a pool slot, or the heap when pool is nullptr.
+        struct Ownership
+        {
+            ObjectPoolBase* pool = nullptr;
+            PoolHandle handle;
+        };
+
+        /**
+         * @brief Gets the pool for a type, creating it in the arena the first time.
+         */
+        template <typename T>
+        ObjectPool<T>& GetPool()
+        {
+            ObjectPoolBase*& pool = pools[std::type_index(typeid(T))];
+            if (!pool)
+                pool = arena.New<ObjectPool<T>>(&arena, OBJECT_POOL_BLOCK_SLOTS);
+            return static_cast<ObjectPool<T>&>(*pool);
+        }
+
+        /**
+         * @brief Registers a new object with the entity store and grid and records its owner.
+         */
+        void Adopt(GameObject* obj, ObjectPoolBase* pool, PoolHandle handle);
+
+        Arena arena; // Scene-lifetime allocations, including the pools; freed after ~Scene() despawns every object
+        std::unordered_map<std::type_index, ObjectPoolBase*> pools; // Pools by object type, allocated in the arena
+        std::vector<Ownership> ownership; // Entity ID to owner of the entity's object
+        bool spawnBatch = false; // Between BeginSpawnBatch() and EndSpawnBatch()
+        std::vector<EntityId> batchIds; // Objects of the current batch, not yet in the grid
+        RenderStats renderStats;
+        AnimationSystem animator; // Advances every entity's animation in UpdateAnim()
+        std::vector<EntityId> visibleIds; // Scratch buffer for the culling query
+        std::vector<Uint32> visibleIndices; // Scratch buffer of visible dense indices
+        std::vector<float> targetX, targetY; // Update() scratch: intended positions
+        std::vector<SDL_FRect> swept; // Update() scratch: hitbox swept over the intended move
+        std::vector<float> resolvedX, resolvedY; // Update() scratch: positions after collision checks
 };
 
 #endif // SCENE_HPP
@@ -0,0 +1,419 @@
+#include "SceneFile.hpp"
+#include "AnimationLibrary.hpp"
+#include "NPC.hpp"
+#include "Player.hpp"
+#include "Scene.hpp"
+#include "TextureManager.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    /// @brief Object type names used in text scene files, in SceneObjectType order.
+    constexpr const char* TYPE_NAMES[static_cast<size_t>(SceneObjectType::Count)] =
+    {
+        "player",
+        "npc"
+    };
+
+    /// @brief AnimState names used in text scene files, in AnimState order.
+    constexpr const char* STATE_NAMES[ANIM_STATE_COUNT] =
+    {
+        "idle_left",
+        "idle_right",
+        "walk_left",
+        "walk_right"
+    };
+
+    template <size_t N>
+    int FindName(const char* const (&names)[N], const std::string& name)
+    {
+        const char* const* found = std::find_if(std::begin(names), std::end(names), [&](const char* n) { return name == n; });
+        return found != std::end(names) ? static_cast<int>(found - std::begin(names)) : -1;
+    }
+
+    template <typename T>
+    void Append(std::vector<Uint8>& out, const T* data, size_t count)
+    {
+        const Uint8* bytes = reinterpret_cast<const Uint8*>(data);
+        out.insert(out.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    /// @brief Copies @p count records from @p cursor if they fit before @p end.
+    template <typename T>
+    bool Take(const Uint8*& cursor, const Uint8* end, std::vector<T>& out, size_t count)
+    {
+        if (count > static_cast<size_t>(end - cursor) / sizeof(T))
+            return false;
+        out.resize(count);
+        if (count > 0)
+            std::memcpy(out.data(), cursor, count * sizeof(T));
+        cursor += count * sizeof(T);
+        return true;
+    }
+}
+
+bool SceneFile::Load(const std::string& path)
+{
+    // Prefer the packed copy, read straight from the mapped archive
+    std::string contents;
+    const void* data = nullptr;
+    size_t size = 0;
+    const AssetArchive& archive = TextureManager::Instance().GetArchive();
+    if (const ArchiveEntry* packed = archive.Find(path))
+    {
+        data = archive.GetData(*packed);
+        size = static_cast<size_t>(packed->size);
+    }
+    else
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            SDL_Log("Failed to open scene %s", path.c_str());
+            Clear();
+            return false;
+        }
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        contents = buffer.str();
+        data = contents.data();
+        size = contents.size();
+    }
+
+    bool loaded;
+    if (size >= sizeof(SCENE_FILE_MAGIC) && std::memcmp(data, SCENE_FILE_MAGIC, sizeof(SCENE_FILE_MAGIC)) == 0)
+        loaded = Read(data, size, path);
+    else
+        loaded = Parse(contents.empty() ? std::string(static_cast<const char*>(data), size) : contents, path);
+    if (!loaded)
+        Clear();
+    return loaded;
+}
+
+bool SceneFile::Parse(const std::string& text, [[maybe_unused]] const std::string& path)
+{
+    Clear();
+    std::istringstream in(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        std::istringstream fields(line);
+        std::string keyword;
+        if (!(fields >> keyword) || keyword[0] == '#')
+            continue;
+        bool valid = true;
+        if (keyword == "tilemap")
+        {
+            std::string map;
+            valid = static_cast<bool>(fields >> map);
+            if (valid)
+                SetTilemap(map);
+        }
+        else if (keyword == "anim")
+        {
+            std::string name, stateName, image;
+            float frameRate = 0.0f;
+            std::vector<std::string> images;
+            valid = static_cast<bool>(fields >> name >> stateName >> frameRate) && frameRate >= 0.0f;
+            int state = FindName(STATE_NAMES, stateName);
+            while (fields >> image)
+                images.push_back(image);
+            valid = valid && state >= 0 && !images.empty();
+            if (valid)
+                AddClip(name, static_cast<AnimState>(state), frameRate, images);
+        }
+        else if (keyword == "object")
+        {
+            std::string typeName, animation;
+            float x, y, width, height, speed = 0.0f;
+            valid = static_cast<bool>(fields >> typeName >> x >> y >> width >> height >> animation);
+            int type = FindName(TYPE_NAMES, typeName);
+            // Speed is optional; trailing whitespace alone does not count as one
+            if (valid && !(fields >> std::ws).eof())
+                valid = static_cast<bool>(fields >> speed);
+            valid = valid && type >= 0 && width > 0.0f && height > 0.0f;
+            if (valid)
+                AddObject(static_cast<SceneObjectType>(type), x, y, width, height, animation, speed);
+        }
+        else if (keyword == "sprite")
+        {
+            int drawLayer = 0;
+            std::string image;
+            SDL_FRect world;
+            valid = static_cast<bool>(fields >> drawLayer >> image >> world.x >> world.y >> world.w >> world.h) && world.w > 0.0f && world.h > 0.0f;
+            if (valid)
+                AddSprite(drawLayer, image, world);
+        }
+        else
+            valid = false;
+        if (!valid)
+        {
+            SDL_Log("Scene %s:%d: cannot parse \"%s\"", path.c_str(), lineNumber, line.c_str());
+            Clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SceneFile::Read(const void* data, size_t size, [[maybe_unused]] const std::string& path)
+{
+    Clear();
+    SceneFileHeader header;
+    if (size < sizeof(header))
+    {
+        SDL_Log("Scene %s is truncated", path.c_str());
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, SCENE_FILE_MAGIC, sizeof(header.magic)) != 0 || header.version != SCENE_FILE_VERSION)
+    {
+        SDL_Log("%s is not a version %u compiled scene", path.c_str(), SCENE_FILE_VERSION);
+        return false;
+    }
+
+    // Each section is one bulk copy
+    const Uint8* cursor = static_cast<const Uint8*>(data) + sizeof(header);
+    const Uint8* end = static_cast<const Uint8*>(data) + size;
+    bool complete = Take(cursor, end, stringOffsets, header.stringCount)
+        && Take(cursor, end, clips, header.clipCount)
+        && Take(cursor, end, frames, header.frameCount)
+        && Take(cursor, end, objects, header.objectCount)
+        && Take(cursor, end, sprites, header.spriteCount)
+        && Take(cursor, end, stringBytes, header.stringBytes);
+    tilemap = header.tilemap;
+
+    // Every string index must land inside the table, so Instantiate() needs no checks
+    auto validString = [&](Uint32 index) { return index < stringOffsets.size(); };
+    bool valid = complete && (stringBytes.empty() || stringBytes.back() == '\0')
+        && std::all_of(stringOffsets.begin(), stringOffsets.end(), [&](Uint32 offset) { return offset < stringBytes.size(); })
+        && (tilemap == SCENE_NO_STRING || validString(tilemap))
+        && std::all_of(frames.begin(), frames.end(), validString)
+        && std::all_of(clips.begin(), clips.end(), [&](const SceneClipRecord& c)
+        {
+            return validString(c.animation) && c.state < ANIM_STATE_COUNT && c.firstFrame <= frames.size() && c.frameCount <= frames.size() - c.firstFrame;
+        })
+        && std::all_of(objects.begin(), objects.end(), [&](const SceneObjectRecord& o)
+        {
+            return o.type < static_cast<Uint32>(SceneObjectType::Count) && (o.animation == SCENE_NO_STRING || validString(o.animation));
+        })
+        && std::all_of(sprites.begin(), sprites.end(), [&](const SceneSpriteRecord& s) { return validString(s.image); });
+    if (!valid)
+    {
+        SDL_Log("Scene %s is truncated or corrupt", path.c_str());
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+std::vector<Uint8> SceneFile::Compile() const
+{
+    SceneFileHeader header = {};
+    std::memcpy(header.magic, SCENE_FILE_MAGIC, sizeof(header.magic));
+    header.version = SCENE_FILE_VERSION;
+    header.stringCount = static_cast<Uint32>(stringOffsets.size());
+    header.stringBytes = static_cast<Uint32>(stringBytes.size());
+    header.clipCount = static_cast<Uint32>(clips.size());
+    header.frameCount = static_cast<Uint32>(frames.size());
+    header.objectCount = static_cast<Uint32>(objects.size());
+    header.spriteCount = static_cast<Uint32>(sprites.size());
+    header.tilemap = tilemap;
+
+    std::vector<Uint8> out;
+    out.reserve(sizeof(header) + stringOffsets.size() * sizeof(Uint32) + clips.size() * sizeof(SceneClipRecord)
+        + frames.size() * sizeof(Uint32) + objects.size() * sizeof(SceneObjectRecord)
+        + sprites.size() * sizeof(SceneSpriteRecord) + stringBytes.size());
+    Append(out, &header, 1);
+    Append(out, stringOffsets.data(), stringOffsets.size());
+    Append(out, clips.data(), clips.size());
+    Append(out, frames.data(), frames.size());
+    Append(out, objects.data(), objects.size());
+    Append(out, sprites.data(), sprites.size());
+    Append(out, stringBytes.data(), stringBytes.size());
+    return out;
+}
+
+bool SceneFile::Save(const std::string& path) const
+{
+    std::vector<Uint8> compiled = Compile();
+    std::ofstream out(path, std::ios::binary);
+    if (!out || !out.write(reinterpret_cast<const char*>(compiled.data()), static_cast<std::streamsize>(compiled.size())))
+    {
+        SDL_Log("Failed to write scene %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+void SceneFile::Clear()
+{
+    stringOffsets.clear();
+    stringBytes.clear();
+    stringIndices.clear();
+    tilemap = SCENE_NO_STRING;
+    clips.clear();
+    frames.clear();
+    objects.clear();
+    sprites.clear();
+}
+
+Uint32 SceneFile::Intern(const std::string& text)
+{
+    // Compiled scenes arrive without the lookup; rebuild it on the first edit
+    if (stringIndices.size() != stringOffsets.size())
+    {
+        stringIndices.clear();
+        for (Uint32 i = 0; i < stringOffsets.size(); ++i)
+            stringIndices.emplace(GetString(i), i);
+    }
+    auto [it, added] = stringIndices.emplace(text, static_cast<Uint32>(stringOffsets.size()));
+    if (added)
+    {
+        stringOffsets.push_back(static_cast<Uint32>(stringBytes.size()));
+        stringBytes.insert(stringBytes.end(), text.begin(), text.end());
+        stringBytes.push_back('\0');
+    }
+    return it->second;
+}
+
+void SceneFile::SetTilemap(const std::string& path)
+{
+    tilemap = path.empty() ? SCENE_NO_STRING : Intern(path);
+}
+
+void SceneFile::AddClip(const std::string& animation, AnimState state, float frameRate, const std::vector<std::string>& images)
+{
+    SceneClipRecord clip = { Intern(animation), static_cast<Uint32>(state), frameRate, static_cast<Uint32>(frames.size()), static_cast<Uint32>(images.size()) };
+    for (const std::string& image : images)
+        frames.push_back(Intern(image));
+    clips.push_back(clip);
+}
+
+void SceneFile::AddObject(SceneObjectType type, float x, float y, float width, float height, const std::string& animation, float speed)
+{
+    Uint32 animationIndex = animation.empty() ? SCENE_NO_STRING : Intern(animation);
+    objects.push_back({ static_cast<Uint32>(type), animationIndex, x, y, width, height, speed, 0 });
+}
+
+void SceneFile::AddSprite(int drawLayer, const std::string& image, const SDL_FRect& world)
+{
+    sprites.push_back({ drawLayer, Intern(image), world.x, world.y, world.w, world.h });
+}
+
+bool SceneFile::Instantiate(Scene& scene) const
+{
+    bool loaded = LoadTilemap(scene);
+    SceneInstance instance;
+    InstantiateSome(scene, instance, SIZE_MAX);
+    return loaded;
+}
+
+bool SceneFile::LoadTilemap(Scene& scene) const
+{
+    return tilemap == SCENE_NO_STRING || scene.LoadTilemap(GetString(tilemap));
+}
+
+void SceneFile::Prepare(SceneInstance& instance) const
+{
+    // One AnimationSet per set name; later clips for the same state win
+    instance.animations.assign(stringOffsets.size(), nullptr);
+    instance.textures.assign(stringOffsets.size(), TextureHandle());
+    std::unordered_map<Uint32, AnimationSetDef> defs;
+    for (const SceneClipRecord& clip : clips)
+    {
+        AnimationClipDef& def = defs[clip.animation][static_cast<AnimState>(clip.state)];
+        def.frameRate = clip.frameRate;
+        def.frames.clear();
+        for (Uint32 f = clip.firstFrame; f < clip.firstFrame + clip.frameCount; ++f)
+            def.frames.emplace_back(GetString(frames[f]));
+    }
+    AnimationLibrary& library = AnimationLibrary::Instance();
+    for (const auto& [name, def] : defs)
+        instance.animations[name] = library.Load(GetString(name), def);
+    for (const SceneObjectRecord& object : objects)
+    {
+        // Sets defined elsewhere, found once per name
+        if (object.animation != SCENE_NO_STRING && !instance.animations[object.animation])
+            instance.animations[object.animation] = library.Find(GetString(object.animation));
+    }
+    instance.prepared = true;
+}
+
+bool SceneFile::InstantiateSome(Scene& scene, SceneInstance& instance, size_t budget) const
+{
+    if (!instance.prepared)
+        Prepare(instance);
+
+    size_t first = instance.objects.size();
+    size_t count = std::min(budget, objects.size() - first);
+    if (count > 0)
+    {
+        scene.BeginSpawnBatch(count);
+        for (size_t i = first; i < first + count; ++i)
+        {
+            const SceneObjectRecord& o = objects[i];
+            AnimationSetRef animation = o.animation != SCENE_NO_STRING ? instance.animations[o.animation] : nullptr;
+            GameObject* obj = nullptr;
+            switch (static_cast<SceneObjectType>(o.type))
+            {
+                case SceneObjectType::Player:
+                    obj = scene.Spawn<Player>(o.x, o.y, o.width, o.height, animation);
+                    break;
+                case SceneObjectType::NPC:
+                    obj = scene.Spawn<NPC>(o.x, o.y, o.width, o.height, animation, o.speed);
+                    break;
+                default:
+                    break;
+            }
+            instance.objects.push_back(obj);
+        }
+        scene.EndSpawnBatch();
+        budget -= count;
+    }
+
+    // Each image is requested once, however many sprites share it
+    first = instance.sprites.size();
+    count = std::min(budget, sprites.size() - first);
+    StaticLayer* layer = nullptr;
+    for (size_t i = first; i < first + count; ++i)
+    {
+        const SceneSpriteRecord& s = sprites[i];
+        if (!layer || layer->GetDrawLayer() != s.layer)
+            layer = &scene.GetStaticLayer(s.layer);
+        TextureHandle& image = instance.textures[s.image];
+        if (!image.IsValid())
+            image = TextureManager::Instance().LoadTextureAsync(GetString(s.image));
+        instance.sprites.push_back({ s.layer, layer->Add(image, { s.x, s.y, s.width, s.height }) });
+    }
+    return instance.objects.size() == objects.size() && instance.sprites.size() == sprites.size();
+}
+
+void SceneFile::Remove(Scene& scene, SceneInstance& instance)
+{
+    for (GameObject* obj : instance.objects)
+    {
+        if (obj)
+            scene.Despawn(obj);
+    }
+    StaticLayer* layer = nullptr;
+    for (const auto& [drawLayer, id] : instance.sprites)
+    {
+        if (!layer || layer->GetDrawLayer() != drawLayer)
+            layer = &scene.GetStaticLayer(drawLayer);
+        layer->Remove(id);
+    }
+    instance = SceneInstance();
+}
+
+const char* SceneFile::GetTypeName(SceneObjectType type)
+{
+    return type < SceneObjectType::Count ? TYPE_NAMES[static_cast<size_t>(type)] : "";
+}
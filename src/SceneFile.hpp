@@ -0,0 +1,294 @@
+#ifndef SCENEFILE_HPP
+#define SCENEFILE_HPP
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "AnimationSet.hpp"
+#include "StaticLayer.hpp"
+#include "TextureHandle.hpp"
+
+class GameObject;
+class Scene;
+
+/**
+ * Scene files.
+ *
+ * A scene is authored as text and can be compiled into a binary form that loads without any
+ * parsing. Both describe the same things: the tilemap, the animation clips the objects use,
+ * the objects and the static sprites. The text form is a list of keyword lines; blank lines
+ * and lines starting with '#' are skipped:
+ * @code
+ * # Map file of the level geometry
+ * tilemap assets/maps/Test.map
+ * # anim <set name> <state> <frames per second> <image>...
+ * anim Player idle_left 0 assets/sprites/Player/Left_Idle.bmp
+ * anim Player walk_left 10 assets/sprites/Player/Moving_Left_A.bmp assets/sprites/Player/Moving_Left_B.bmp
+ * # object <type> <x> <y> <width> <height> <anim set> [speed]
+ * object player 436 204 44 66 Player
+ * object npc 100 100 44 66 Player 200
+ * # sprite <draw layer> <image> <x> <y> <width> <height>
+ * sprite -50 assets/sprites/Tiles/Tiles.bmp 320 320 64 32
+ * @endcode
+ *
+ * The compiled (.scn) form starts with a SceneFileHeader, followed by the string offsets, the
+ * SceneClipRecord, frame, SceneObjectRecord and SceneSpriteRecord arrays, and the string bytes.
+ * Every path and name is stored once in the string table and referred to by its index, so
+ * records are fixed size and loading them is a copy. All fields are little-endian. The asset
+ * packer compiles .scene files as it packs them.
+ */
+
+constexpr char SCENE_FILE_MAGIC[8] = { 'A', '2', 'D', 'S', 'C', 'N', '\0', '\0' };
+constexpr Uint32 SCENE_FILE_VERSION = 1;
+
+/// @brief String index meaning "none".
+constexpr Uint32 SCENE_NO_STRING = 0xFFFFFFFFu;
+
+/**
+ * @enum SceneObjectType
+ * @brief Object classes a scene file can create.
+ */
+enum class SceneObjectType : Uint32
+{
+    Player,
+    NPC,
+    Count
+};
+
+/**
+ * @struct SceneFileHeader
+ * @brief First bytes of a compiled scene file.
+ */
+struct SceneFileHeader
+{
+    char magic[8];      // SCENE_FILE_MAGIC
+    Uint32 version;     // SCENE_FILE_VERSION
+    Uint32 stringCount; // Strings in the string table
+    Uint32 stringBytes; // Size of the string bytes, each string NUL-terminated
+    Uint32 clipCount;   // SceneClipRecord records
+    Uint32 frameCount;  // Frame image string indices, shared by all clips
+    Uint32 objectCount; // SceneObjectRecord records
+    Uint32 spriteCount; // SceneSpriteRecord records
+    Uint32 tilemap;     // String index of the map file, or SCENE_NO_STRING
+    Uint32 reserved[2];
+};
+
+/**
+ * @struct SceneClipRecord
+ * @brief One clip of a named animation set.
+ */
+struct SceneClipRecord
+{
+    Uint32 animation;  // String index of the set name
+    Uint32 state;      // AnimState
+    float frameRate;   // Frames per second; 0 holds the first frame
+    Uint32 firstFrame; // Index of the clip's first frame in the frame array
+    Uint32 frameCount; // Frames in the clip
+};
+
+/**
+ * @struct SceneObjectRecord
+ * @brief One object to create.
+ */
+struct SceneObjectRecord
+{
+    Uint32 type;      // SceneObjectType
+    Uint32 animation; // String index of the animation set name, or SCENE_NO_STRING
+    float x, y;       // Top-left position in world space
+    float width, height;
+    float speed;      // Movement speed, used by types that move on their own
+    Uint32 reserved;
+};
+
+/**
+ * @struct SceneSpriteRecord
+ * @brief One sprite of a static layer.
+ */
+struct SceneSpriteRecord
+{
+    Sint32 layer; // Renderer layer of the static layer
+    Uint32 image; // String index of the image path
+    float x, y;   // World-space rectangle
+    float width, height;
+};
+
+static_assert(sizeof(SceneFileHeader) == 48, "SceneFileHeader layout is part of the file format");
+static_assert(sizeof(SceneClipRecord) == 20, "SceneClipRecord layout is part of the file format");
+static_assert(sizeof(SceneObjectRecord) == 32, "SceneObjectRecord layout is part of the file format");
+static_assert(sizeof(SceneSpriteRecord) == 24, "SceneSpriteRecord layout is part of the file format");
+
+/**
+ * @struct SceneInstance
+ * @brief What SceneFile::InstantiateSome() has created in a scene so far, so a scene file can
+ * be created a few objects at a time and removed again.
+ */
+struct SceneInstance
+{
+    std::vector<GameObject*> objects; // Objects created, in record order
+    std::vector<std::pair<int, StaticSpriteId>> sprites; // Static sprites created, with their draw layer
+    std::vector<TextureHandle> textures; // Sprite images by string index, referenced while the instance lives
+    std::vector<AnimationSetRef> animations; // Animation sets by string index, held while the instance lives
+    bool prepared = false; // Animation sets resolved
+};
+
+/**
+ * @class SceneFile
+ * @brief The contents of a scene file, ready to be created in a Scene.
+ *
+ * Paths and names are interned when a scene is parsed or built in code, so the records only
+ * hold string indices. Instantiate() resolves each distinct animation set and image once,
+ * then creates the objects straight from the records: the object type is an integer, and no
+ * strings are compared or copied per object.
+ *
+ * Usage:
+ *   - Call Load() with a .scene or compiled .scn path, or build one with the Add*() functions.
+ *   - Call Instantiate() to fill a scene, any number of times, or InstantiateSome() to spread the
+ *     work over several frames.
+ *   - Call Save() to write the compiled form.
+ */
+class SceneFile
+{
+    public:
+        /**
+         * @brief Replaces the contents with a scene file, text or compiled.
+         *
+         * The copy in the mounted asset archive is used when there is one.
+         *
+         * @param path Path of the scene file.
+         * @return true on success. On failure the scene file is left empty and the reason is logged.
+         */
+        bool Load(const std::string& path);
+
+        /**
+         * @brief Replaces the contents with a scene in text form.
+         * @param text The file contents.
+         * @param path Used in error messages.
+         * @return true on success; errors are logged with their line number.
+         */
+        bool Parse(const std::string& text, const std::string& path);
+
+        /**
+         * @brief Replaces the contents with a scene in compiled form.
+         * @param data The file contents.
+         * @param size Size of @p data in bytes.
+         * @param path Used in error messages.
+         * @return true on success.
+         */
+        bool Read(const void* data, size_t size, const std::string& path);
+
+        /**
+         * @brief Gets the compiled form of the scene.
+         */
+        std::vector<Uint8> Compile() const;
+
+        /**
+         * @brief Writes the compiled form of the scene to a file.
+         * @return true if the file was written.
+         */
+        bool Save(const std::string& path) const;
+
+        /**
+         * @brief Removes everything.
+         */
+        void Clear();
+
+        /**
+         * @brief Sets the map file of the scene's tilemap.
+         */
+        void SetTilemap(const std::string& path);
+
+        /**
+         * @brief Adds a clip to a named animation set, replacing the set's clip for that state.
+         * @param animation Name of the set, shared through the AnimationLibrary.
+         * @param state State the clip plays in.
+         * @param frameRate Frames per second; 0 holds the first frame.
+         * @param frames Image paths, in playback order.
+         */
+        void AddClip(const std::string& animation, AnimState state, float frameRate, const std::vector<std::string>& frames);
+
+        /**
+         * @brief Adds an object.
+         * @param animation Name of its animation set, or empty for none. Sets without clips in
+         *                  this file are looked up in the AnimationLibrary.
+         */
+        void AddObject(SceneObjectType type, float x, float y, float width, float height, const std::string& animation, float speed = 0.0f);
+
+        /**
+         * @brief Adds a sprite to the static layer drawn on @p drawLayer.
+         */
+        void AddSprite(int drawLayer, const std::string& image, const SDL_FRect& world);
+
+        /**
+         * @brief Creates the scene's contents in a scene.
+         *
+         * Loads the tilemap, builds each animation set once, reserves room for every object and
+         * then spawns them, and adds the sprites to the static layers. Textures load in the
+         * background as usual.
+         *
+         * @param scene The scene to fill; existing objects are kept.
+         * @return false if the tilemap failed to load; everything else is still created.
+         */
+        bool Instantiate(Scene& scene) const;
+
+        /**
+         * @brief Loads the tilemap the scene file names, if any, into @p scene.
+         * @return false if the tilemap failed to load.
+         */
+        bool LoadTilemap(Scene& scene) const;
+
+        /**
+         * @brief Creates up to @p budget more of the objects and sprites in a scene.
+         *
+         * Objects come first, then sprites, in file order. The tilemap is not loaded; see
+         * LoadTilemap(). Objects created this way belong to the instance: remove them with
+         * Remove() rather than despawning them one by one.
+         *
+         * @param scene The scene to fill.
+         * @param instance What has been created so far; start with an empty one.
+         * @param budget Most objects and sprites to create in this call.
+         * @return true once everything has been created.
+         */
+        bool InstantiateSome(Scene& scene, SceneInstance& instance, size_t budget) const;
+
+        /**
+         * @brief Removes everything an instance created from the scene and releases its textures.
+         */
+        static void Remove(Scene& scene, SceneInstance& instance);
+
+        /**
+         * @brief Gets the number of objects.
+         */
+        size_t GetObjectCount() const { return objects.size(); }
+
+        /**
+         * @brief Gets the number of static sprites.
+         */
+        size_t GetSpriteCount() const { return sprites.size(); }
+
+        /**
+         * @brief Gets the name an object type has in text scene files, e.g. "npc".
+         */
+        static const char* GetTypeName(SceneObjectType type);
+
+    private:
+        /// @brief Resolves the animation sets used by the objects.
+        void Prepare(SceneInstance& instance) const;
+
+        /// @brief Gets a string's index, adding it to the table the first time.
+        Uint32 Intern(const std::string& text);
+
+        /// @brief Gets a string from the table.
+        const char* GetString(Uint32 index) const { return stringBytes.data() + stringOffsets[index]; }
+
+        std::vector<Uint32> stringOffsets; // Start of each string in stringBytes
+        std::vector<char> stringBytes;     // NUL-terminated strings
+        std::unordered_map<std::string, Uint32> stringIndices; // Interning lookup, only used while authoring
+        Uint32 tilemap = SCENE_NO_STRING;
+        std::vector<SceneClipRecord> clips;
+        std::vector<Uint32> frames; // String indices of clip frame images
+        std::vector<SceneObjectRecord> objects;
+        std::vector<SceneSpriteRecord> sprites;
+};
+
+#endif // SCENEFILE_HPP
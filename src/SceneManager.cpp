@@ -0,0 +1,153 @@
+#include "SceneManager.hpp"
+#include "GameConfig.hpp"
+#include "Profiler.hpp"
+#include "TextureManager.hpp"
+#include <algorithm>
+
+SceneManager::~SceneManager()
+{
+    Clear();
+}
+
+void SceneManager::Push(const std::string& path)
+{
+    StartLoading(path, Transition::Push);
+}
+
+void SceneManager::Replace(const std::string& path)
+{
+    StartLoading(path, Transition::Replace);
+}
+
+void SceneManager::Pop()
+{
+    ++pops;
+}
+
+void SceneManager::StartLoading(const std::string& path, Transition transition)
+{
+    // The job keeps the file alive, so a dropped load may still be reading it
+    pending = std::make_unique<PendingScene>();
+    pending->transition = transition;
+    pending->path = path;
+    std::shared_ptr<PendingFile> read = std::make_shared<PendingFile>();
+    pending->read = read;
+    pending->job = JobSystem::Instance().Schedule([read, path]() { read->loaded = read->file.Load(path); });
+}
+
+bool SceneManager::Build(size_t budget, bool block)
+{
+    PendingScene& load = *pending;
+    if (load.job)
+    {
+        // Without workers a job only runs when waited on
+        if (block || JobSystem::Instance().GetWorkerCount() == 0)
+            JobSystem::Instance().Wait(load.job);
+        if (!load.job->done.load(std::memory_order_acquire))
+            return false;
+        load.job.reset();
+        if (!load.read->loaded)
+        {
+            SDL_Log("Scene %s not loaded, keeping the current scene", load.path.c_str());
+            pending.reset();
+            return false;
+        }
+        load.scene = std::make_unique<Scene>();
+        load.scene->GetWorld().SetSynchronous(synchronous);
+        load.read->file.LoadTilemap(*load.scene);
+    }
+
+    if (!load.built)
+    {
+        load.built = load.read->file.InstantiateSome(*load.scene, load.instance, budget);
+        if (!load.built)
+            return false;
+        load.read.reset();
+        CollectUploads();
+    }
+    if (block)
+        return true;
+    // Wait for the scene's own uploads too, so it never appears drawn with placeholders
+    const TextureManager& textures = TextureManager::Instance();
+    std::vector<TextureHandle>& uploads = load.uploads;
+    uploads.erase(std::remove_if(uploads.begin(), uploads.end(), [&](const TextureHandle& texture)
+    {
+        return textures.GetStatus(texture) != TextureStatus::Loading;
+    }), uploads.end());
+    return uploads.empty();
+}
+
+void SceneManager::CollectUploads()
+{
+    const TextureManager& textures = TextureManager::Instance();
+    PendingScene& load = *pending;
+    auto collect = [&](const TextureHandle& texture)
+    {
+        if (textures.GetStatus(texture) == TextureStatus::Loading)
+            load.uploads.push_back(texture);
+    };
+    collect(load.scene->GetTilemap().GetTileset());
+    for (const TextureHandle& texture : load.instance.textures)
+        collect(texture);
+    for (const AnimationSetRef& animation : load.instance.animations)
+    {
+        if (!animation)
+            continue;
+        for (size_t state = 0; state < ANIM_STATE_COUNT; ++state)
+        {
+            for (const AnimationFrame& frame : animation->GetClip(static_cast<AnimState>(state)).frames)
+                collect(frame.texture);
+        }
+    }
+}
+
+void SceneManager::Show()
+{
+    // The scene it replaces goes only now, so textures both use were never released
+    if (pending->transition == Transition::Replace && !scenes.empty())
+        scenes.pop_back();
+    scenes.push_back(std::move(pending->scene));
+    pending.reset();
+}
+
+bool SceneManager::Advance()
+{
+    PROFILE_ZONE("SceneManager::Advance");
+    bool changed = false;
+    for (; pops > 0 && !scenes.empty(); --pops)
+    {
+        scenes.pop_back();
+        changed = true;
+    }
+    pops = 0;
+    if (pending && Build(synchronous ? SIZE_MAX : SCENE_BUILD_BUDGET, synchronous))
+    {
+        Show();
+        changed = true;
+    }
+    return changed;
+}
+
+void SceneManager::FinishLoading()
+{
+    if (pending && Build(SIZE_MAX, true))
+        Show();
+}
+
+void SceneManager::SetSynchronous(bool synchronous)
+{
+    this->synchronous = synchronous;
+    for (const std::unique_ptr<Scene>& scene : scenes)
+        scene->GetWorld().SetSynchronous(synchronous);
+    if (pending && pending->scene)
+        pending->scene->GetWorld().SetSynchronous(synchronous);
+}
+
+void SceneManager::Clear()
+{
+    pending.reset();
+    pops = 0;
+    // Top first, the reverse of the order they were shown in
+    while (!scenes.empty())
+        scenes.pop_back();
+}
@@ -0,0 +1,159 @@
+#ifndef SCENEMANAGER_HPP
+#define SCENEMANAGER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "JobSystem.hpp"
+#include "Scene.hpp"
+#include "SceneFile.hpp"
+
+/**
+ * @class SceneManager
+ * @brief The Engine's stack of scenes, with the next scene loaded behind the current one.
+ *
+ * Only the top scene is updated and rendered; the scenes below it are kept as they were and
+ * resume when it is popped. Push() and Replace() do not stop the game: the scene file is read
+ * on the JobSystem, then a new scene is created from it SCENE_BUILD_BUDGET objects and sprites
+ * per step while the current scene keeps running. Once it is complete and the textures it uses
+ * have been uploaded, Advance() makes it the top scene in a single step. Only the new scene's own
+ * textures are waited for, so other loads in flight do not hold it back.
+ *
+ * Textures are shared through the TextureManager, which hands out the same texture for the
+ * same path. Because a new scene is built while the scene it follows still holds its handles,
+ * sprites both scenes use are never released, so they are never evicted and reloaded.
+ *
+ * Scenes are only changed inside Advance(), so Push(), Pop() and Replace() may be called from
+ * anywhere on the main thread. They are not thread-safe: an object may only call them from its
+ * Update() if its RequiresMainThread() returns true. The Engine calls Advance()
+ * at the start of each simulation step, so scene changes fall on the same step in a replay as
+ * they did when the input was recorded.
+ */
+class SceneManager
+{
+    public:
+        SceneManager() = default;
+        SceneManager(const SceneManager&) = delete;
+        SceneManager& operator=(const SceneManager&) = delete;
+        ~SceneManager();
+
+        /**
+         * @brief Starts loading a scene to put on top of the current one.
+         *
+         * Replaces any load still in progress.
+         *
+         * @param path Path of the scene file, text or compiled.
+         */
+        void Push(const std::string& path);
+
+        /**
+         * @brief Starts loading a scene to take the place of the top scene, which is destroyed
+         * once the new one is shown.
+         *
+         * Replaces any load still in progress.
+         *
+         * @param path Path of the scene file, text or compiled.
+         */
+        void Replace(const std::string& path);
+
+        /**
+         * @brief Removes the top scene at the next Advance(), showing the one below it.
+         *
+         * Does nothing when the stack is empty.
+         */
+        void Pop();
+
+        /**
+         * @brief Applies pending pops and advances the scene being loaded. Call once per simulation
+         * step on the main thread, before the top scene updates.
+         *
+         * @return true if the top scene changed.
+         */
+        bool Advance();
+
+        /**
+         * @brief Blocks until the scene being loaded, if any, is on the stack.
+         *
+         * Used for the first scene, so the game never starts without one.
+         */
+        void FinishLoading();
+
+        /**
+         * @brief Makes a scene load complete within the next Advance(), without waiting for its
+         * textures, and makes every scene's world stream synchronously.
+         *
+         * Used by input recording and replay, whose runs must switch scenes on the same step.
+         */
+        void SetSynchronous(bool synchronous);
+
+        /**
+         * @brief Destroys every scene and cancels any load in progress.
+         */
+        void Clear();
+
+        /**
+         * @brief Gets the top scene, or nullptr when the stack is empty.
+         */
+        Scene* GetActive() const { return scenes.empty() ? nullptr : scenes.back().get(); }
+
+        /**
+         * @brief Gets the number of scenes on the stack.
+         */
+        size_t GetDepth() const { return scenes.size(); }
+
+        /**
+         * @brief Checks if a scene is being loaded.
+         */
+        bool IsLoading() const { return pending != nullptr; }
+
+    private:
+        /// @brief Where the scene being loaded goes once it is complete.
+        enum class Transition
+        {
+            Push,
+            Replace
+        };
+
+        /// @brief A scene file read by a job. Shared with the job so it can outlive the load.
+        struct PendingFile
+        {
+            SceneFile file;
+            bool loaded = false;
+        };
+
+        /// @brief A scene being loaded behind the top one.
+        struct PendingScene
+        {
+            Transition transition = Transition::Push;
+            std::string path;
+            JobHandle job; // Reads the file, reset once it has finished
+            std::shared_ptr<PendingFile> read;
+            std::unique_ptr<Scene> scene; // Created once the file has been read
+            SceneInstance instance;
+            bool built = false; // Every object and sprite created
+            std::vector<TextureHandle> uploads; // Textures the scene uses that were still loading when it was built
+        };
+
+        /// @brief Starts reading a scene file, dropping any load in progress.
+        void StartLoading(const std::string& path, Transition transition);
+
+        /**
+         * @brief Advances the load; returns true once the scene is ready to show.
+         * @param budget Most objects and sprites to create.
+         * @param block Wait for the file instead of checking on it, and do not wait for textures.
+         */
+        bool Build(size_t budget, bool block);
+
+        /// @brief Collects the scene's textures that are still loading into PendingScene::uploads.
+        void CollectUploads();
+
+        /// @brief Puts the loaded scene on the stack.
+        void Show();
+
+        std::vector<std::unique_ptr<Scene>> scenes; // Bottom to top
+        std::unique_ptr<PendingScene> pending;
+        size_t pops = 0; // Pop() calls not yet applied
+        bool synchronous = false;
+};
+
+#endif // SCENEMANAGER_HPP
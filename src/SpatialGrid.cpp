@@ -0,0 +1,171 @@
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : cellSize(cellSize), invCellSize(1.0f / cellSize)
+{
+}
+
+bool SpatialGrid::CellRange::operator==(const CellRange& other) const
+{
+    return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 && y1 == other.y1;
+}
+
+SpatialGrid::CellRange SpatialGrid::GetCellRange(const SDL_FRect& rect) const
+{
+    // Edges are included so a rectangle touching a cell boundary is found from both sides
+    return {
+        static_cast<int>(std::floor(rect.x * invCellSize)),
+        static_cast<int>(std::floor(rect.y * invCellSize)),
+        static_cast<int>(std::floor((rect.x + rect.w) * invCellSize)),
+        static_cast<int>(std::floor((rect.y + rect.h) * invCellSize))
+    };
+}
+
+Uint64 SpatialGrid::CellKey(int cx, int cy)
+{
+    return (static_cast<Uint64>(static_cast<Uint32>(cx)) << 32) | static_cast<Uint32>(cy);
+}
+
+void SpatialGrid::Insert(EntityId id, const SDL_FRect& rect)
+{
+    CellRange range = GetCellRange(rect);
+    for (int cy = range.y0; cy <= range.y1; ++cy)
+        for (int cx = range.x0; cx <= range.x1; ++cx)
+            cells[CellKey(cx, cy)].push_back({id, rect});
+}
+
+void SpatialGrid::InsertMany(const EntityId* ids, const SDL_FRect* rects, size_t count)
+{
+    std::vector<std::pair<Uint64, Entry>> staged;
+    staged.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        CellRange range = GetCellRange(rects[i]);
+        for (int cy = range.y0; cy <= range.y1; ++cy)
+            for (int cx = range.x0; cx <= range.x1; ++cx)
+                staged.push_back({ CellKey(cx, cy), { ids[i], rects[i] } });
+    }
+    std::sort(staged.begin(), staged.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    // One lookup and one allocation per cell
+    size_t distinct = 0;
+    for (size_t i = 0; i < staged.size(); ++i)
+        distinct += i == 0 || staged[i].first != staged[i - 1].first;
+    cells.reserve(cells.size() + distinct);
+    for (size_t begin = 0, end; begin < staged.size(); begin = end)
+    {
+        end = begin + 1;
+        while (end < staged.size() && staged[end].first == staged[begin].first)
+            ++end;
+        std::vector<Entry>& cell = cells[staged[begin].first];
+        cell.reserve(cell.size() + (end - begin));
+        for (size_t i = begin; i < end; ++i)
+            cell.push_back(staged[i].second);
+    }
+}
+
+void SpatialGrid::Remove(EntityId id, const SDL_FRect& rect)
+{
+    CellRange range = GetCellRange(rect);
+    for (int cy = range.y0; cy <= range.y1; ++cy)
+    {
+        for (int cx = range.x0; cx <= range.x1; ++cx)
+        {
+            auto it = cells.find(CellKey(cx, cy));
+            if (it == cells.end())
+                continue;
+            std::vector<Entry>& bucket = it->second;
+            auto pos = std::find_if(bucket.begin(), bucket.end(), [id](const Entry& e) { return e.id == id; });
+            if (pos != bucket.end())
+            {
+                // Order within a cell does not matter, so swap-and-pop
+                *pos = bucket.back();
+                bucket.pop_back();
+            }
+            if (bucket.empty())
+                cells.erase(it);
+        }
+    }
+}
+
+void SpatialGrid::Move(EntityId id, const SDL_FRect& oldRect, const SDL_FRect& newRect)
+{
+    CellRange range = GetCellRange(oldRect);
+    if (!(range == GetCellRange(newRect)))
+    {
+        Remove(id, oldRect);
+        Insert(id, newRect);
+        return;
+    }
+
+    // Same cells: refresh the stored rectangle in place
+    for (int cy = range.y0; cy <= range.y1; ++cy)
+    {
+        for (int cx = range.x0; cx <= range.x1; ++cx)
+        {
+            auto it = cells.find(CellKey(cx, cy));
+            if (it == cells.end())
+                continue;
+            for (Entry& e : it->second)
+            {
+                if (e.id == id)
+                {
+                    e.rect = newRect;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool SpatialGrid::AnyIntersecting(const SDL_FRect& rect, EntityId ignore) const
+{
+    CellRange range = GetCellRange(rect);
+    for (int cy = range.y0; cy <= range.y1; ++cy)
+    {
+        for (int cx = range.x0; cx <= range.x1; ++cx)
+        {
+            auto it = cells.find(CellKey(cx, cy));
+            if (it == cells.end())
+                continue;
+            for (const Entry& e : it->second)
+            {
+                if (e.id != ignore && GameObject::Intersects(rect, e.rect))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+void SpatialGrid::Query(const SDL_FRect& rect, std::vector<EntityId>& out) const
+{
+    CellRange range = GetCellRange(rect);
+    size_t first = out.size();
+    for (int cy = range.y0; cy <= range.y1; ++cy)
+    {
+        for (int cx = range.x0; cx <= range.x1; ++cx)
+        {
+            auto it = cells.find(CellKey(cx, cy));
+            if (it == cells.end())
+                continue;
+            for (const Entry& e : it->second)
+            {
+                if (GameObject::Intersects(rect, e.rect))
+                    out.push_back(e.id);
+            }
+        }
+    }
+    // Entities spanning several cells show up once per cell
+    std::sort(out.begin() + first, out.end());
+    out.erase(std::unique(out.begin() + first, out.end()), out.end());
+}
+
+void SpatialGrid::Clear()
+{
+    cells.clear();
+}
+
+float SpatialGrid::GetCellSize() const { return cellSize; }
@@ -0,0 +1,196 @@
+#ifndef SPATIALGRID_HPP
+#define SPATIALGRID_HPP
+
+#include <SDL3/SDL.h>
+#include <unordered_map>
+#include <vector>
+#include "GameObject.hpp"
+
+/**
+ * @class SpatialGrid
+ * @brief Uniform-grid broadphase that buckets entities by the cells their hitboxes overlap.
+ *
+ * The grid is sparse: only occupied cells are stored, keyed by their integer cell coordinates,
+ * so the world has no fixed bounds. Each cell keeps a copy of the rectangle of every entity in it,
+ * so intersection queries never leave the cell's own memory. Entities are inserted with the
+ * rectangle they currently occupy and must be moved with their previous rectangle so the grid
+ * can be updated incrementally.
+ *
+ * Usage:
+ *   - Call Insert() when an entity enters the scene and Remove() when it leaves.
+ *   - Call Move() after changing an entity's hitbox.
+ *   - Use AnyIntersecting(), ForEachNear() or Query() to find entities near a rectangle.
+ */
+class SpatialGrid
+{
+    public:
+        /**
+         * @brief Constructs an empty grid.
+         * @param cellSize Width and height of a single cell, in pixels.
+         */
+        explicit SpatialGrid(float cellSize);
+
+        /**
+         * @brief Adds an entity to every cell overlapped by the given rectangle.
+         * @param id The entity to insert.
+         * @param rect The rectangle the entity currently occupies (normally its hitbox).
+         */
+        void Insert(EntityId id, const SDL_FRect& rect);
+
+        /**
+         * @brief Adds many entities at once, e.g. when a level is loaded.
+         *
+         * Same result as calling Insert() for each, but the entries are sorted by cell first, so
+         * every cell is looked up and grown once rather than once per entity.
+         *
+         * @param ids The entities to insert.
+         * @param rects The rectangle of each entity.
+         * @param count Number of entities.
+         */
+        void InsertMany(const EntityId* ids, const SDL_FRect* rects, size_t count);
+
+        /**
+         * @brief Removes an entity from every cell overlapped by the given rectangle.
+         * @param id The entity to remove.
+         * @param rect The rectangle the entity was inserted or last moved with.
+         */
+        void Remove(EntityId id, const SDL_FRect& rect);
+
+        /**
+         * @brief Moves an entity from the cells of its old rectangle to the cells of its new one.
+         *
+         * When both rectangles cover the same cell range, which is the common case for entities
+         * moving a few pixels per frame, only the stored rectangles are updated in place.
+         *
+         * @param id The entity to move.
+         * @param oldRect The rectangle the entity was last inserted or moved with.
+         * @param newRect The rectangle the entity occupies now.
+         */
+        void Move(EntityId id, const SDL_FRect& oldRect, const SDL_FRect& newRect);
+
+        /**
+         * @brief Checks if any entity other than @p ignore has a rectangle intersecting @p rect.
+         * @param rect The rectangle to test.
+         * @param ignore Entity to skip (usually the entity being moved), may be INVALID_ENTITY.
+         * @return True if an intersecting rectangle was found, false otherwise.
+         */
+        bool AnyIntersecting(const SDL_FRect& rect, EntityId ignore) const;
+
+        /**
+         * @brief Like AnyIntersecting(), but tests each nearby entity against a rectangle supplied by the caller.
+         *
+         * Used to test against where entities are about to be rather than where the grid last saw
+         * them. Cells within @p reach of @p rect are searched, so @p rectOf may return rectangles
+         * that extend up to @p reach beyond the stored ones.
+         *
+         * @param rect The rectangle to test.
+         * @param ignore Entity to skip, may be INVALID_ENTITY.
+         * @param reach How far the supplied rectangles may extend past the stored ones.
+         * @param rectOf Called as rectOf(EntityId) to get the rectangle to test against.
+         * @return True if an intersecting rectangle was found, false otherwise.
+         */
+        template <typename RectOf>
+        bool AnyIntersecting(const SDL_FRect& rect, EntityId ignore, float reach, RectOf&& rectOf) const;
+
+        /**
+         * @brief Calls @p fn for every entity whose stored rectangle comes within @p reach of @p rect.
+         *
+         * An entity spanning several searched cells is visited once per cell, so @p fn must not
+         * mind duplicates. Nothing is allocated.
+         *
+         * @param rect The rectangle to search around.
+         * @param reach Extra distance searched on every side of @p rect.
+         * @param fn Called as fn(EntityId).
+         */
+        template <typename Fn>
+        void ForEachNear(const SDL_FRect& rect, float reach, Fn&& fn) const;
+
+        /**
+         * @brief Collects every entity whose stored rectangle intersects @p rect.
+         *
+         * Results are appended to @p out without duplicates, in ascending ID order.
+         *
+         * @param rect The rectangle to query.
+         * @param out Vector that receives the matching entity IDs.
+         */
+        void Query(const SDL_FRect& rect, std::vector<EntityId>& out) const;
+
+        /**
+         * @brief Removes every entity from the grid.
+         */
+        void Clear();
+
+        /**
+         * @brief Gets the cell size the grid was constructed with.
+         */
+        float GetCellSize() const;
+
+    private:
+        /// @brief Inclusive range of cell coordinates covered by a rectangle.
+        struct CellRange
+        {
+            int x0, y0, x1, y1;
+            bool operator==(const CellRange& other) const;
+        };
+
+        /// @brief An entity in a cell, with a copy of its rectangle for cache-local tests.
+        struct Entry
+        {
+            EntityId id;
+            SDL_FRect rect;
+        };
+
+        CellRange GetCellRange(const SDL_FRect& rect) const;
+        static Uint64 CellKey(int cx, int cy);
+
+        float cellSize;
+        float invCellSize;
+
+        /// @brief Occupied cells, keyed by packed (x, y) cell coordinates.
+        std::unordered_map<Uint64, std::vector<Entry>> cells;
+};
+
+template <typename RectOf>
+bool SpatialGrid::AnyIntersecting(const SDL_FRect& rect, EntityId ignore, float reach, RectOf&& rectOf) const
+{
+    SDL_FRect area = { rect.x - reach, rect.y - reach, rect.w + 2 * reach, rect.h + 2 * reach };
+    CellRange range = GetCellRange(area);
+    for (int cy = range.y0; cy <= range.y1; ++cy)
+    {
+        for (int cx = range.x0; cx <= range.x1; ++cx)
+        {
+            auto it = cells.find(CellKey(cx, cy));
+            if (it == cells.end())
+                continue;
+            for (const Entry& e : it->second)
+            {
+                if (e.id != ignore && GameObject::Intersects(area, e.rect) && GameObject::Intersects(rect, rectOf(e.id)))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <typename Fn>
+void SpatialGrid::ForEachNear(const SDL_FRect& rect, float reach, Fn&& fn) const
+{
+    SDL_FRect area = { rect.x - reach, rect.y - reach, rect.w + 2 * reach, rect.h + 2 * reach };
+    CellRange range = GetCellRange(area);
+    for (int cy = range.y0; cy <= range.y1; ++cy)
+    {
+        for (int cx = range.x0; cx <= range.x1; ++cx)
+        {
+            auto it = cells.find(CellKey(cx, cy));
+            if (it == cells.end())
+                continue;
+            for (const Entry& e : it->second)
+            {
+                if (GameObject::Intersects(area, e.rect))
+                    fn(e.id);
+            }
+        }
+    }
+}
+
+#endif // SPATIALGRID_HPP
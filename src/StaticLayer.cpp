@@ -0,0 +1,250 @@
+#include "StaticLayer.hpp"
+#include "Profiler.hpp"
+#include "Renderer.hpp"
+#include "TextureManager.hpp"
+#include <algorithm>
+#include <cmath>
+
+StaticLayer::StaticLayer(int drawLayer)
+    : drawLayer(drawLayer)
+{
+}
+
+StaticLayer::~StaticLayer()
+{
+    Clear();
+}
+
+Uint64 StaticLayer::Key(int cx, int cy)
+{
+    return (static_cast<Uint64>(static_cast<Uint32>(cx)) << 32) | static_cast<Uint32>(cy);
+}
+
+template <typename Fn>
+void StaticLayer::ForEachChunk(const SDL_FRect &rect, Fn &&fn) const
+{
+    const float size = STATIC_LAYER_CHUNK_SIZE;
+    int cx0 = static_cast<int>(std::floor(rect.x / size));
+    int cy0 = static_cast<int>(std::floor(rect.y / size));
+    int cx1 = static_cast<int>(std::floor((rect.x + rect.w) / size));
+    int cy1 = static_cast<int>(std::floor((rect.y + rect.h) / size));
+    for (int cy = cy0; cy <= cy1; ++cy)
+    {
+        for (int cx = cx0; cx <= cx1; ++cx)
+            fn(cx, cy);
+    }
+}
+
+StaticSpriteId StaticLayer::Add(TextureHandle texture, const SDL_FRect &world)
+{
+    StaticSpriteId id;
+    if (!freeIds.empty())
+    {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    else
+    {
+        id = static_cast<StaticSpriteId>(sprites.size());
+        sprites.emplace_back();
+    }
+    sprites[id] = { std::move(texture), world, true };
+    ++liveSprites;
+    Link(id);
+    return id;
+}
+
+void StaticLayer::Move(StaticSpriteId id, const SDL_FRect &world)
+{
+    if (id >= sprites.size() || !sprites[id].live)
+        return;
+    Unlink(id);
+    sprites[id].world = world;
+    Link(id);
+}
+
+void StaticLayer::Remove(StaticSpriteId id)
+{
+    if (id >= sprites.size() || !sprites[id].live)
+        return;
+    Unlink(id);
+    sprites[id] = {};
+    freeIds.push_back(id);
+    --liveSprites;
+}
+
+void StaticLayer::Clear()
+{
+    for (Chunk *chunk : cached)
+        SDL_DestroyTexture(chunk->texture);
+    cached.clear();
+    chunks.clear();
+    sprites.clear();
+    freeIds.clear();
+    liveSprites = 0;
+}
+
+void StaticLayer::Link(StaticSpriteId id)
+{
+    ForEachChunk(sprites[id].world, [&](int cx, int cy)
+    {
+        Chunk &chunk = chunks[Key(cx, cy)];
+        chunk.sprites.push_back(id);
+        chunk.dirty = true;
+    });
+}
+
+void StaticLayer::Unlink(StaticSpriteId id)
+{
+    ForEachChunk(sprites[id].world, [&](int cx, int cy)
+    {
+        auto it = chunks.find(Key(cx, cy));
+        if (it == chunks.end())
+            return;
+        Chunk &chunk = it->second;
+        chunk.sprites.erase(std::find(chunk.sprites.begin(), chunk.sprites.end(), id));
+        chunk.dirty = true;
+        if (chunk.sprites.empty())
+        {
+            Release(chunk);
+            chunks.erase(it);
+        }
+    });
+}
+
+bool StaticLayer::IsReady(const Chunk &chunk) const
+{
+    const TextureManager &textures = TextureManager::Instance();
+    for (StaticSpriteId id : chunk.sprites)
+    {
+        if (textures.GetStatus(sprites[id].texture) == TextureStatus::Loading)
+            return false;
+    }
+    return true;
+}
+
+bool StaticLayer::Bake(Renderer &renderer, Chunk &chunk, int cx, int cy)
+{
+    const int size = static_cast<int>(STATIC_LAYER_CHUNK_SIZE);
+    if (!chunk.texture)
+    {
+        chunk.texture = renderer.CreateLayerTexture(size, size);
+        if (!chunk.texture)
+            return false;
+        cached.push_back(&chunk);
+    }
+
+    bool baked = renderer.BeginLayerBake(chunk.texture);
+    if (baked)
+    {
+        SDL_Renderer *sdlRenderer = renderer.GetSDLRenderer();
+        const TextureManager &textures = TextureManager::Instance();
+        float originX = cx * STATIC_LAYER_CHUNK_SIZE, originY = cy * STATIC_LAYER_CHUNK_SIZE;
+        for (StaticSpriteId id : chunk.sprites)
+        {
+            // Parts outside the chunk fall off the texture's edges
+            const Sprite &sprite = sprites[id];
+            const TextureRegion &region = textures.Resolve(sprite.texture);
+            SDL_FRect dest = { sprite.world.x - originX, sprite.world.y - originY, sprite.world.w, sprite.world.h };
+            if (region.texture)
+                SDL_RenderTexture(sdlRenderer, region.texture, &region.src, &dest);
+        }
+    }
+    renderer.EndLayerBake();
+    if (!baked)
+        return false;
+    chunk.dirty = false;
+    ++bakes;
+    return true;
+}
+
+void StaticLayer::DrawDirect(Renderer &renderer, const Chunk &chunk, int cx, int cy, const SDL_FRect &camera)
+{
+    const TextureManager &textures = TextureManager::Instance();
+    SDL_FRect bounds = { cx * STATIC_LAYER_CHUNK_SIZE, cy * STATIC_LAYER_CHUNK_SIZE, STATIC_LAYER_CHUNK_SIZE, STATIC_LAYER_CHUNK_SIZE };
+    for (StaticSpriteId id : chunk.sprites)
+    {
+        // Clip to the chunk so sprites spanning several chunks are drawn exactly once
+        const Sprite &sprite = sprites[id];
+        SDL_FRect clip;
+        if (!SDL_GetRectIntersectionFloat(&sprite.world, &bounds, &clip))
+            continue;
+        TextureRegion region = textures.Resolve(sprite.texture);
+        float scaleX = region.src.w / sprite.world.w, scaleY = region.src.h / sprite.world.h;
+        region.src = { region.src.x + (clip.x - sprite.world.x) * scaleX, region.src.y + (clip.y - sprite.world.y) * scaleY,
+                       clip.w * scaleX, clip.h * scaleY };
+        renderer.RenderTexture(region, { clip.x - camera.x, clip.y - camera.y, clip.w, clip.h }, drawLayer);
+        ++directSprites;
+    }
+}
+
+void StaticLayer::Render(Renderer &renderer, const SDL_FRect &camera)
+{
+    PROFILE_ZONE("StaticLayer::Render");
+    ++frame;
+    drawnChunks = 0;
+    directSprites = 0;
+    if (chunks.empty() || !renderer.GetSDLRenderer())
+        return;
+    int bakeBudget = STATIC_LAYER_BAKES_PER_FRAME;
+    ForEachChunk(camera, [&](int cx, int cy)
+    {
+        auto it = chunks.find(Key(cx, cy));
+        if (it == chunks.end())
+            return;
+        Chunk &chunk = it->second;
+        chunk.lastDrawn = frame;
+        if (chunk.dirty || !chunk.texture)
+        {
+            // A chunk is only baked from loaded textures, never from placeholders
+            if (bakeBudget <= 0 || !IsReady(chunk) || !Bake(renderer, chunk, cx, cy))
+            {
+                DrawDirect(renderer, chunk, cx, cy, camera);
+                return;
+            }
+            --bakeBudget;
+        }
+        SDL_FRect dest = { cx * STATIC_LAYER_CHUNK_SIZE - camera.x, cy * STATIC_LAYER_CHUNK_SIZE - camera.y, STATIC_LAYER_CHUNK_SIZE, STATIC_LAYER_CHUNK_SIZE };
+        renderer.RenderTexture(TextureRegion{ chunk.texture, { 0.0f, 0.0f, STATIC_LAYER_CHUNK_SIZE, STATIC_LAYER_CHUNK_SIZE } }, dest, drawLayer);
+        ++drawnChunks;
+    });
+    TrimCache();
+}
+
+void StaticLayer::Release(Chunk &chunk)
+{
+    if (!chunk.texture)
+        return;
+    SDL_DestroyTexture(chunk.texture);
+    chunk.texture = nullptr;
+    cached.erase(std::find(cached.begin(), cached.end(), &chunk));
+}
+
+void StaticLayer::TrimCache()
+{
+    if (cached.size() <= STATIC_LAYER_CHUNK_CACHE)
+        return;
+    // Oldest first; chunks drawn this frame are still queued in the renderer and must survive
+    std::sort(cached.begin(), cached.end(), [](const Chunk *a, const Chunk *b) { return a->lastDrawn < b->lastDrawn; });
+    size_t excess = cached.size() - STATIC_LAYER_CHUNK_CACHE;
+    size_t evicted = 0;
+    while (evicted < excess && cached[evicted]->lastDrawn != frame)
+    {
+        SDL_DestroyTexture(cached[evicted]->texture);
+        cached[evicted]->texture = nullptr;
+        ++evicted;
+    }
+    cached.erase(cached.begin(), cached.begin() + evicted);
+}
+
+StaticLayerStats StaticLayer::GetStats() const
+{
+    StaticLayerStats stats;
+    stats.sprites = liveSprites;
+    stats.chunks = chunks.size();
+    stats.cachedChunks = cached.size();
+    stats.bakes = bakes;
+    stats.drawnChunks = drawnChunks;
+    stats.directSprites = directSprites;
+    return stats;
+}
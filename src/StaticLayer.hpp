@@ -0,0 +1,160 @@
+#ifndef STATICLAYER_HPP
+#define STATICLAYER_HPP
+
+#include <SDL3/SDL.h>
+#include <unordered_map>
+#include <vector>
+#include "GameConfig.hpp"
+#include "TextureHandle.hpp"
+
+class Renderer;
+
+/// @brief Identifies a sprite in a StaticLayer. IDs of removed sprites are reused.
+using StaticSpriteId = Uint32;
+
+/// @brief The ID of no sprite.
+constexpr StaticSpriteId INVALID_STATIC_SPRITE = 0xFFFFFFFF;
+
+/**
+ * @struct StaticLayerStats
+ * @brief StaticLayer contents and chunk texture cache counters.
+ */
+struct StaticLayerStats
+{
+    size_t sprites = 0;       // Sprites in the layer
+    size_t chunks = 0;        // Chunks holding at least one sprite
+    size_t cachedChunks = 0;  // Chunk textures currently held
+    Uint64 bakes = 0;         // Chunk textures drawn since the layer was created
+    size_t drawnChunks = 0;   // Chunks blitted by the last Render()
+    size_t directSprites = 0; // Sprites the last Render() drew one by one instead
+};
+
+/**
+ * @class StaticLayer
+ * @brief A draw layer of sprites that rarely change, drawn as cached chunk textures.
+ *
+ * The world is divided into square chunks of STATIC_LAYER_CHUNK_SIZE pixels. Each chunk lists
+ * the sprites overlapping it, and the first time it is visible its sprites are drawn into a
+ * texture of its own. From then on Render() blits one texture per visible chunk, whatever the
+ * number of sprites in it, until a sprite in the chunk is added, moved or removed and the chunk
+ * is drawn again. Per frame the cost follows the number of visible chunks, not sprites.
+ *
+ * Chunks are only baked once all of their sprites' textures have loaded, and at most
+ * STATIC_LAYER_BAKES_PER_FRAME chunks are baked per Render() so a sudden jump of the camera
+ * does not stall one frame. Until a chunk is baked its sprites are drawn one by one, clipped to
+ * the chunk, so the picture never changes. At most STATIC_LAYER_CHUNK_CACHE chunk textures are
+ * kept; the least recently drawn are released first.
+ *
+ * Within a chunk, sprites are drawn in the order they were added; moving a sprite draws it last.
+ */
+class StaticLayer
+{
+    public:
+        /**
+         * @brief Creates an empty layer.
+         * @param drawLayer Renderer layer the chunks are submitted on.
+         */
+        explicit StaticLayer(int drawLayer);
+
+        /**
+         * @brief Destroys the chunk textures.
+         */
+        ~StaticLayer();
+
+        StaticLayer(const StaticLayer &) = delete;
+        StaticLayer &operator=(const StaticLayer &) = delete;
+
+        /**
+         * @brief Adds a sprite, marking the chunks it overlaps for redrawing.
+         * @param texture The image to draw; it may still be loading.
+         * @param world World-space rectangle to draw it into.
+         * @return ID for moving or removing the sprite.
+         */
+        StaticSpriteId Add(TextureHandle texture, const SDL_FRect &world);
+
+        /**
+         * @brief Moves a sprite, marking the chunks it leaves and enters for redrawing.
+         */
+        void Move(StaticSpriteId id, const SDL_FRect &world);
+
+        /**
+         * @brief Removes a sprite, marking the chunks it overlapped for redrawing.
+         */
+        void Remove(StaticSpriteId id);
+
+        /**
+         * @brief Removes every sprite and releases the chunk textures.
+         */
+        void Clear();
+
+        /**
+         * @brief Draws the chunks overlapping the camera, baking the ones that changed.
+         * @param renderer The renderer to draw with.
+         * @param camera Visible world-space rectangle.
+         */
+        void Render(Renderer &renderer, const SDL_FRect &camera);
+
+        int GetDrawLayer() const { return drawLayer; }
+
+        /**
+         * @brief Gets the layer contents and chunk cache counters.
+         */
+        StaticLayerStats GetStats() const;
+
+    private:
+        struct Sprite
+        {
+            TextureHandle texture;
+            SDL_FRect world = {};
+            bool live = false;
+        };
+
+        struct Chunk
+        {
+            std::vector<StaticSpriteId> sprites; // In draw order
+            SDL_Texture *texture = nullptr;      // Baked sprites, or nullptr when not cached
+            bool dirty = true;                   // Sprites changed since the texture was drawn
+            Uint64 lastDrawn = 0;                // Frame the chunk was last drawn, for cache eviction
+        };
+
+        /// @brief Packs chunk coordinates into a map key.
+        static Uint64 Key(int cx, int cy);
+
+        /// @brief Calls fn(cx, cy) for every chunk @p rect overlaps.
+        template <typename Fn>
+        void ForEachChunk(const SDL_FRect &rect, Fn &&fn) const;
+
+        /// @brief Registers a sprite with the chunks it overlaps.
+        void Link(StaticSpriteId id);
+
+        /// @brief Unregisters a sprite from the chunks it overlaps, dropping chunks left empty.
+        void Unlink(StaticSpriteId id);
+
+        /// @brief Checks if every sprite in a chunk has a texture that finished loading.
+        bool IsReady(const Chunk &chunk) const;
+
+        /// @brief Draws a chunk's sprites into its texture, creating it if needed.
+        bool Bake(Renderer &renderer, Chunk &chunk, int cx, int cy);
+
+        /// @brief Submits a chunk's sprites one by one, clipped to the chunk.
+        void DrawDirect(Renderer &renderer, const Chunk &chunk, int cx, int cy, const SDL_FRect &camera);
+
+        /// @brief Releases a chunk's texture.
+        void Release(Chunk &chunk);
+
+        /// @brief Releases the least recently drawn chunk textures until the cache fits.
+        void TrimCache();
+
+        int drawLayer;
+        std::vector<Sprite> sprites;
+        std::vector<StaticSpriteId> freeIds;
+        size_t liveSprites = 0;
+        std::unordered_map<Uint64, Chunk> chunks;
+        std::vector<Chunk *> cached; // Chunks holding a texture
+        Uint64 frame = 0;
+        Uint64 bakes = 0;
+        size_t drawnChunks = 0;
+        size_t directSprites = 0;
+};
+
+#endif // STATICLAYER_HPP
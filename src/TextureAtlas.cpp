@@ -0,0 +1,272 @@
+#include "TextureAtlas.hpp"
+#include <algorithm>
+
+TextureAtlas::TextureAtlas(int pageSize, int padding)
+    : pageSize(pageSize), padding(padding)
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    Clean();
+}
+
+bool TextureAtlas::Fits(int width, int height) const
+{
+    // Each image owns its padding on the right and bottom, plus a shared border at the page edge
+    return width + 2 * padding <= pageSize && height + 2 * padding <= pageSize;
+}
+
+bool TextureAtlas::Add(SDL_Surface *surface, SDL_Renderer *renderer, TextureRegion &out, bool allowNewPage)
+{
+    if (!surface || !Fits(surface->w, surface->h))
+        return false;
+    int w = surface->w + padding;
+    int h = surface->h + padding;
+
+    // Space released by earlier images first, then the skyline
+    int pageIndex = -1, block = -1, node = -1, x = 0, y = 0;
+    for (size_t i = 0; i < pages.size() && block < 0 && node < 0; ++i)
+    {
+        pageIndex = static_cast<int>(i);
+        block = FindFreeBlock(pages[i], w, h);
+        if (block >= 0)
+        {
+            x = pages[i].freeBlocks[block].x;
+            y = pages[i].freeBlocks[block].y;
+        }
+        else
+            node = FindPosition(pages[i], w, h, x, y);
+    }
+    if (block < 0 && node < 0)
+    {
+        if (!allowNewPage || !AddPage(renderer))
+            return false;
+        pageIndex = static_cast<int>(pages.size()) - 1;
+        node = FindPosition(pages.back(), w, h, x, y);
+        if (node < 0)
+            return false;
+    }
+
+    // Upload in the page's pixel format (images decoded by the TextureManager already are)
+    SDL_Surface *converted = surface->format == SDL_PIXELFORMAT_RGBA32 ? surface : SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+    if (!converted)
+    {
+        SDL_Log("Failed to convert surface for atlas: %s", SDL_GetError());
+        return false;
+    }
+    Page &page = pages[pageIndex];
+    SDL_Rect dest = { x, y, surface->w, surface->h };
+    bool uploaded = SDL_UpdateTexture(page.texture, &dest, converted->pixels, converted->pitch);
+    if (converted != surface)
+        SDL_DestroySurface(converted);
+    if (!uploaded)
+    {
+        SDL_Log("Failed to upload atlas region: %s", SDL_GetError());
+        return false;
+    }
+
+    if (block >= 0)
+        TakeFreeBlock(page, block, w, h);
+    else
+        Place(page, node, x, y, w, h);
+    ++page.images;
+    out.texture = page.texture;
+    out.src = { static_cast<float>(x), static_cast<float>(y), static_cast<float>(surface->w), static_cast<float>(surface->h) };
+    return true;
+}
+
+int TextureAtlas::FindPosition(const Page &page, int w, int h, int &outX, int &outY) const
+{
+    int best = -1;
+    int bestY = pageSize;
+    int bestWidth = pageSize;
+    const std::vector<SkylineNode> &sky = page.skyline;
+    for (size_t i = 0; i < sky.size(); ++i)
+    {
+        int x = sky[i].x;
+        if (x + w > pageSize)
+            break;
+
+        // The block rests on the highest segment it spans
+        int y = sky[i].y;
+        int remaining = w;
+        for (size_t j = i; remaining > 0; ++j)
+        {
+            y = std::max(y, sky[j].y);
+            remaining -= sky[j].width;
+        }
+        if (y + h > pageSize)
+            continue;
+
+        // Bottom-left rule, ties broken by the narrowest segment to limit fragmentation
+        if (y < bestY || (y == bestY && sky[i].width < bestWidth))
+        {
+            best = static_cast<int>(i);
+            bestY = y;
+            bestWidth = sky[i].width;
+            outX = x;
+            outY = y;
+        }
+    }
+    return best;
+}
+
+int TextureAtlas::FindFreeBlock(const Page &page, int w, int h) const
+{
+    int best = -1;
+    long long bestArea = 0;
+    for (size_t i = 0; i < page.freeBlocks.size(); ++i)
+    {
+        const SDL_Rect &free = page.freeBlocks[i];
+        long long area = static_cast<long long>(free.w) * free.h;
+        if (free.w >= w && free.h >= h && (best < 0 || area < bestArea))
+        {
+            best = static_cast<int>(i);
+            bestArea = area;
+        }
+    }
+    return best;
+}
+
+void TextureAtlas::TakeFreeBlock(Page &page, int index, int w, int h)
+{
+    // Guillotine split: what is left to the right keeps the block's height, what is left below
+    // spans its full width
+    SDL_Rect free = page.freeBlocks[index];
+    page.freeBlocks.erase(page.freeBlocks.begin() + index);
+    if (free.w > w)
+        page.freeBlocks.push_back({ free.x + w, free.y, free.w - w, h });
+    if (free.h > h)
+        page.freeBlocks.push_back({ free.x, free.y + h, free.w, free.h - h });
+}
+
+void TextureAtlas::MergeFreeBlocks(Page &page)
+{
+    std::vector<SDL_Rect> &blocks = page.freeBlocks;
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (size_t i = 0; i < blocks.size() && !merged; ++i)
+        {
+            for (size_t j = i + 1; j < blocks.size() && !merged; ++j)
+            {
+                SDL_Rect &a = blocks[i];
+                const SDL_Rect &b = blocks[j];
+                if (a.y == b.y && a.h == b.h && (a.x + a.w == b.x || b.x + b.w == a.x))
+                {
+                    a.x = std::min(a.x, b.x);
+                    a.w += b.w;
+                    merged = true;
+                }
+                else if (a.x == b.x && a.w == b.w && (a.y + a.h == b.y || b.y + b.h == a.y))
+                {
+                    a.y = std::min(a.y, b.y);
+                    a.h += b.h;
+                    merged = true;
+                }
+                if (merged)
+                    blocks.erase(blocks.begin() + j);
+            }
+        }
+    }
+}
+
+void TextureAtlas::Place(Page &page, int index, int x, int y, int w, int h)
+{
+    std::vector<SkylineNode> &sky = page.skyline;
+    sky.insert(sky.begin() + index, { x, y + h, w });
+
+    // Trim or remove the segments now covered by the new one
+    for (size_t i = index + 1; i < sky.size();)
+    {
+        int prevEnd = sky[i - 1].x + sky[i - 1].width;
+        if (sky[i].x >= prevEnd)
+            break;
+        int shrink = prevEnd - sky[i].x;
+        if (sky[i].width <= shrink)
+        {
+            sky.erase(sky.begin() + i);
+            continue;
+        }
+        sky[i].x += shrink;
+        sky[i].width -= shrink;
+        break;
+    }
+
+    // Merge neighbours at the same height
+    for (size_t i = 0; i + 1 < sky.size();)
+    {
+        if (sky[i].y == sky[i + 1].y)
+        {
+            sky[i].width += sky[i + 1].width;
+            sky.erase(sky.begin() + i + 1);
+        }
+        else
+            ++i;
+    }
+}
+
+bool TextureAtlas::AddPage(SDL_Renderer *renderer)
+{
+    SDL_Texture *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, pageSize, pageSize);
+    if (!texture)
+    {
+        SDL_Log("Failed to create atlas page: %s", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    // Static textures start undefined, so clear the page to transparent once
+    std::vector<Uint32> clear(static_cast<size_t>(pageSize) * pageSize, 0);
+    SDL_UpdateTexture(texture, nullptr, clear.data(), pageSize * static_cast<int>(sizeof(Uint32)));
+
+    // The top-left padding is reserved by starting the skyline one border in
+    pages.push_back({ texture, { { padding, padding, pageSize - padding } }, {}, 0 });
+    return true;
+}
+
+void TextureAtlas::Clean()
+{
+    for (Page &page : pages)
+        SDL_DestroyTexture(page.texture);
+    pages.clear();
+}
+
+void TextureAtlas::Release(const TextureRegion &region)
+{
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+        if (pages[i].texture != region.texture)
+            continue;
+        Page &page = pages[i];
+        if (--page.images <= 0)
+        {
+            SDL_DestroyTexture(page.texture);
+            pages.erase(pages.begin() + i);
+            return;
+        }
+
+        // Clear the image and its padding so a later image placed here has a transparent border
+        SDL_Rect block = { static_cast<int>(region.src.x), static_cast<int>(region.src.y),
+                           static_cast<int>(region.src.w) + padding, static_cast<int>(region.src.h) + padding };
+        std::vector<Uint32> clear(static_cast<size_t>(block.w) * block.h, 0);
+        SDL_UpdateTexture(page.texture, &block, clear.data(), block.w * static_cast<int>(sizeof(Uint32)));
+        page.freeBlocks.push_back(block);
+        MergeFreeBlocks(page);
+        return;
+    }
+}
+
+size_t TextureAtlas::GetPageCount() const { return pages.size(); }
+
+size_t TextureAtlas::GetByteSize() const
+{
+    return pages.size() * GetPageByteSize();
+}
+
+size_t TextureAtlas::GetPageByteSize() const
+{
+    return static_cast<size_t>(pageSize) * pageSize * sizeof(Uint32);
+}
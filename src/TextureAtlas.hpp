@@ -0,0 +1,130 @@
+#ifndef TEXTUREATLAS_HPP
+#define TEXTUREATLAS_HPP
+
+#include <SDL3/SDL.h>
+#include <vector>
+#include "TextureRegion.hpp"
+
+/**
+ * @class TextureAtlas
+ * @brief Packs images into a small number of large textures ("pages") using a skyline packer.
+ *
+ * Each page tracks its free space as a skyline: a list of horizontal segments describing the
+ * lowest free y position for every x range. A new image is placed at the position that keeps
+ * it lowest (bottom-left rule), and a transparent padding border is reserved around it so
+ * filtering never samples a neighbouring image. When no page has room, a new one is created.
+ *
+ * The skyline only grows, so space given back by Release() is tracked separately: the released
+ * block is cleared to transparent and kept in the page's free list, where later images are placed
+ * before the skyline is raised. Neighbouring free blocks are merged so larger images fit too.
+ * Once every image on a page has been released the whole page is destroyed.
+ *
+ * Usage:
+ *   - Call Add() with a surface to upload it into the atlas and get its region.
+ *   - Call Release() when a region is no longer needed.
+ *   - Call Clean() to destroy all pages.
+ */
+class TextureAtlas
+{
+    public:
+        /**
+         * @brief Constructs an empty atlas.
+         * @param pageSize Width and height of each page texture, in pixels.
+         * @param padding Transparent border kept around every image, in pixels.
+         */
+        TextureAtlas(int pageSize, int padding);
+
+        /**
+         * @brief Destroys all page textures.
+         */
+        ~TextureAtlas();
+
+        /**
+         * @brief Packs a surface into the atlas and uploads its pixels.
+         *
+         * @param surface The image to add. It is not modified or freed.
+         * @param renderer The renderer used to create page textures.
+         * @param out Receives the page texture and the image's rectangle in it.
+         * @param allowNewPage Create a page when no existing page has room.
+         * @return true on success, false if the image does not fit in an empty page, there was no room
+         *         and no new page was allowed, or the upload failed.
+         */
+        bool Add(SDL_Surface *surface, SDL_Renderer *renderer, TextureRegion &out, bool allowNewPage = true);
+
+        /**
+         * @brief Checks if an image of the given size fits in an empty page.
+         */
+        bool Fits(int width, int height) const;
+
+        /**
+         * @brief Releases a region returned by Add(), destroying its page once the page has no images left.
+         * @param region The region to release. It must not be drawn afterwards.
+         */
+        void Release(const TextureRegion &region);
+
+        /**
+         * @brief Destroys all pages. Regions returned earlier become invalid.
+         */
+        void Clean();
+
+        /**
+         * @brief Gets the number of page textures currently allocated.
+         */
+        size_t GetPageCount() const;
+
+        /**
+         * @brief Gets the GPU memory used by all pages, in bytes.
+         */
+        size_t GetByteSize() const;
+
+        /**
+         * @brief Gets the GPU memory of one page, in bytes.
+         */
+        size_t GetPageByteSize() const;
+
+    private:
+        /// @brief One segment of a page's skyline.
+        struct SkylineNode
+        {
+            int x, y, width;
+        };
+
+        /// @brief A single atlas texture and the skyline describing its free space.
+        struct Page
+        {
+            SDL_Texture *texture;
+            std::vector<SkylineNode> skyline;
+            std::vector<SDL_Rect> freeBlocks; // Released blocks below the skyline, cleared to transparent
+            int images = 0; // Images added and not yet released
+        };
+
+        /**
+         * @brief Finds the smallest free block of a page that holds a w x h block.
+         * @return Index into the page's free blocks, or -1 if none is large enough.
+         */
+        int FindFreeBlock(const Page &page, int w, int h) const;
+
+        /// @brief Takes a w x h block from the top-left of free block @p index, keeping the rest free.
+        void TakeFreeBlock(Page &page, int index, int w, int h);
+
+        /// @brief Merges free blocks that share a whole edge, until no two do.
+        static void MergeFreeBlocks(Page &page);
+
+        /**
+         * @brief Finds where a w x h block would go in a page.
+         * @return Index of the skyline node to place it at, or -1 if it does not fit.
+         */
+        int FindPosition(const Page &page, int w, int h, int &outX, int &outY) const;
+
+        /// @brief Raises the skyline after placing a block at node @p index.
+        void Place(Page &page, int index, int x, int y, int w, int h);
+
+        /// @brief Creates a new, fully transparent page texture.
+        bool AddPage(SDL_Renderer *renderer);
+
+        int pageSize;
+        int padding;
+        std::vector<Page> pages;
+};
+
+#endif // TEXTUREATLAS_HPP
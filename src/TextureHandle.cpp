@@ -0,0 +1,50 @@
+#include "TextureHandle.hpp"
+#include "TextureManager.hpp"
+#include <utility>
+
+TextureHandle::TextureHandle(Uint32 id)
+    : id(id)
+{
+    if (id)
+        TextureManager::Instance().AddRef(id);
+}
+
+TextureHandle::TextureHandle(const TextureHandle &other)
+    : TextureHandle(other.id)
+{
+}
+
+TextureHandle::TextureHandle(TextureHandle &&other) noexcept
+    : id(std::exchange(other.id, 0))
+{
+}
+
+TextureHandle &TextureHandle::operator=(const TextureHandle &other)
+{
+    if (id != other.id)
+    {
+        if (other.id)
+            TextureManager::Instance().AddRef(other.id);
+        if (id)
+            TextureManager::Instance().Release(id);
+        id = other.id;
+    }
+    return *this;
+}
+
+TextureHandle &TextureHandle::operator=(TextureHandle &&other) noexcept
+{
+    if (this != &other)
+    {
+        if (id)
+            TextureManager::Instance().Release(id);
+        id = std::exchange(other.id, 0);
+    }
+    return *this;
+}
+
+TextureHandle::~TextureHandle()
+{
+    if (id)
+        TextureManager::Instance().Release(id);
+}
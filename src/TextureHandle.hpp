@@ -0,0 +1,43 @@
+#ifndef TEXTUREHANDLE_HPP
+#define TEXTUREHANDLE_HPP
+
+#include <SDL3/SDL.h>
+
+/**
+ * @class TextureHandle
+ * @brief Counted reference to a texture owned by the TextureManager.
+ *
+ * A handle exists as soon as a load is requested, before the image has streamed in, so it can
+ * be stored and drawn right away: TextureManager::Resolve() gives the placeholder texture until
+ * the image is uploaded. While any handle to a texture exists the texture is never evicted;
+ * once the last one is destroyed the texture becomes a candidate for LRU eviction.
+ *
+ * Copying and destroying handles is thread-safe. A default-constructed handle refers to no texture.
+ */
+class TextureHandle
+{
+    public:
+        TextureHandle() = default;
+        TextureHandle(const TextureHandle &other);
+        TextureHandle(TextureHandle &&other) noexcept;
+        TextureHandle &operator=(const TextureHandle &other);
+        TextureHandle &operator=(TextureHandle &&other) noexcept;
+        ~TextureHandle();
+
+        /// @brief Gets the TextureManager entry this handle refers to; 0 means no texture.
+        Uint32 GetId() const { return id; }
+
+        bool IsValid() const { return id != 0; }
+        bool operator==(const TextureHandle &other) const { return id == other.id; }
+        bool operator!=(const TextureHandle &other) const { return id != other.id; }
+
+    private:
+        friend class TextureManager;
+
+        /// @brief Takes a new reference to entry @p id. Only the TextureManager creates handles.
+        explicit TextureHandle(Uint32 id);
+
+        Uint32 id = 0;
+};
+
+#endif // TEXTUREHANDLE_HPP
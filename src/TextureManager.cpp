@@ -1,4 +1,11 @@
 #include "TextureManager.hpp"
+#include <algorithm>
+
+namespace
+{
+    constexpr int PLACEHOLDER_SIZE = 8;   // Placeholder width and height in pixels
+    constexpr int PLACEHOLDER_CHECKER = 4; // Checkerboard square size in pixels
+}
 
 TextureManager& TextureManager::Instance() 
 {
@@ -6,39 +13,486 @@ TextureManager& TextureManager::Instance()
     return instance;
 }
 
-SDL_Texture *TextureManager::LoadTexture(const std::string &path, SDL_Renderer *renderer)
+TextureManager::TextureManager()
+{
+    AddChunk(); // Slot 0 backs the empty handle
+    entryCount.store(1, std::memory_order_release);
+}
+
+TextureManager::~TextureManager()
+{
+    for (std::atomic<Entry *> &chunk : entryChunks)
+        delete[] chunk.load(std::memory_order_acquire);
+}
+
+void TextureManager::AddChunk()
+{
+    size_t index = entryCount.load(std::memory_order_relaxed) >> TEXTURE_ENTRY_CHUNK_BITS;
+    entryChunks[index].store(new Entry[TEXTURE_ENTRY_CHUNK_SIZE], std::memory_order_release);
+}
+
+TextureHandle TextureManager::LoadTexture(const std::string &path, SDL_Renderer *renderer)
 {
     // Check if the texture is already cached
     auto it = textureCache.find(path);
     if (it != textureCache.end())
-        return it->second;
+    {
+        ++hits;
+        Touch(GetEntry(it->second));
+        TextureHandle handle(it->second);
+        // Already streaming in: finish that load instead of starting another
+        if (GetEntry(it->second).status == TextureStatus::Loading)
+            FinishLoading(it->second, renderer);
+        return handle;
+    }
+
+    // Take the reference before uploading so the budget check cannot evict it straight away
+    Uint32 id = AddEntry(path);
+    if (id == 0)
+        return TextureHandle();
+    TextureHandle handle(id);
+    CreatePlaceholder(renderer);
+    Upload(handle.GetId(), Open(path), renderer);
+    return handle;
+}
+
+TextureHandle TextureManager::LoadTextureAsync(const std::string &path)
+{
+    auto it = textureCache.find(path);
+    if (it != textureCache.end())
+    {
+        ++hits;
+        Touch(GetEntry(it->second));
+        return TextureHandle(it->second);
+    }
+
+    Uint32 id = AddEntry(path);
+    if (id == 0)
+        return TextureHandle();
+    if (const ArchiveEntry *packed = archive.Find(path))
+    {
+        // Already decoded in the mapping: nothing for a worker to do, queue it for upload
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        decoded.push_back({ id, archive.CreateSurface(*packed) });
+        return TextureHandle(id);
+    }
+    if (JobSystem::Instance().GetWorkerCount() == 0)
+    {
+        // A job would only run when something waits on it; ProcessUploads() decodes these instead
+        inlineDecodes.push_back(id);
+        return TextureHandle(id);
+    }
+    GetEntry(id).job = JobSystem::Instance().Schedule([this, path, id]()
+    {
+        SDL_Surface *surface = Decode(path);
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        decoded.push_back({ id, surface });
+    });
+    return TextureHandle(id);
+}
+
+void TextureManager::DecodeInline(size_t byteBudget)
+{
+    size_t done = 0, bytes = 0;
+    while (done < inlineDecodes.size() && (done == 0 || bytes < byteBudget))
+    {
+        Uint32 id = inlineDecodes[done++];
+        SDL_Surface *surface = Decode(GetEntry(id).path);
+        if (surface)
+            bytes += static_cast<size_t>(surface->pitch) * surface->h;
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        decoded.push_back({ id, surface });
+    }
+    inlineDecodes.erase(inlineDecodes.begin(), inlineDecodes.begin() + done);
+}
+
+size_t TextureManager::ProcessUploads(SDL_Renderer *renderer, size_t byteBudget)
+{
+    FreeFailed();
+    if (!inlineDecodes.empty())
+        DecodeInline(byteBudget);
+    {
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        uploadQueue.insert(uploadQueue.end(), decoded.begin(), decoded.end());
+        decoded.clear();
+    }
+    if (uploadQueue.empty())
+        return 0;
+    CreatePlaceholder(renderer);
+
+    // Workers finish in any order; upload in request order so atlas layout is reproducible.
+    // IDs are reused, so they say nothing about when a texture was requested.
+    std::sort(uploadQueue.begin(), uploadQueue.end(), [this](const DecodedImage &a, const DecodedImage &b)
+    {
+        return GetEntry(a.id).request < GetEntry(b.id).request;
+    });
+
+    size_t uploaded = 0, bytes = 0;
+    while (uploaded < uploadQueue.size() && (uploaded == 0 || bytes < byteBudget))
+    {
+        const DecodedImage &image = uploadQueue[uploaded];
+        if (image.surface)
+            bytes += static_cast<size_t>(image.surface->pitch) * image.surface->h;
+        Upload(image.id, image.surface, renderer);
+        ++uploaded;
+    }
+    uploadQueue.erase(uploadQueue.begin(), uploadQueue.begin() + uploaded);
+    return uploaded;
+}
+
+void TextureManager::FinishLoading(SDL_Renderer *renderer)
+{
+    for (Uint32 id = 1; id < GetEntryCount(); ++id)
+    {
+        Entry &entry = GetEntry(id);
+        JobSystem::Instance().Wait(entry.job);
+        entry.job.reset();
+    }
+    DecodeInline(SIZE_MAX);
+    ProcessUploads(renderer, SIZE_MAX);
+}
+
+void TextureManager::FinishLoading(Uint32 id, SDL_Renderer *renderer)
+{
+    Entry &entry = GetEntry(id);
+    SDL_Surface *surface = nullptr;
+    auto inlineIt = std::find(inlineDecodes.begin(), inlineDecodes.end(), id);
+    if (inlineIt != inlineDecodes.end())
+    {
+        inlineDecodes.erase(inlineIt);
+        surface = Decode(entry.path);
+    }
+    else
+    {
+        JobSystem::Instance().Wait(entry.job);
+        entry.job.reset();
+        auto matches = [id](const DecodedImage &image) { return image.id == id; };
+        auto queuedIt = std::find_if(uploadQueue.begin(), uploadQueue.end(), matches);
+        if (queuedIt != uploadQueue.end())
+        {
+            surface = queuedIt->surface;
+            uploadQueue.erase(queuedIt);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(decodedMutex);
+            auto decodedIt = std::find_if(decoded.begin(), decoded.end(), matches);
+            if (decodedIt != decoded.end())
+            {
+                surface = decodedIt->surface;
+                decoded.erase(decodedIt);
+            }
+        }
+    }
+    CreatePlaceholder(renderer);
+    Upload(id, surface, renderer);
+}
+
+const TextureRegion &TextureManager::Resolve(TextureHandle handle) const
+{
+    if (handle.id < GetEntryCount() && GetEntry(handle.id).status == TextureStatus::Ready)
+        return GetEntry(handle.id).region;
+    return placeholder;
+}
+
+TextureStatus TextureManager::GetStatus(TextureHandle handle) const
+{
+    if (!handle.IsValid() || handle.id >= GetEntryCount())
+        return TextureStatus::Failed;
+    return GetEntry(handle.id).status;
+}
+
+size_t TextureManager::GetPendingCount() const { return pendingCount; }
+
+void TextureManager::SetBudget(size_t bytes)
+{
+    budgetBytes = bytes;
+    EnforceBudget();
+}
+
+TextureStats TextureManager::GetStats() const
+{
+    TextureStats stats;
+    stats.residentBytes = residentBytes;
+    stats.budgetBytes = budgetBytes;
+    stats.gpuBytes = GetGpuBytes();
+    stats.textures = residentTextures;
+    for (Uint32 id = 1; id < GetEntryCount(); ++id)
+    {
+        if (GetEntry(id).refCount.load(std::memory_order_relaxed) > 0)
+            ++stats.referenced;
+    }
+    stats.hits = hits;
+    stats.misses = misses;
+    stats.evictions = evictions;
+    return stats;
+}
+
+void TextureManager::AddRef(Uint32 id)
+{
+    GetEntry(id).refCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TextureManager::Release(Uint32 id)
+{
+    Entry &entry = GetEntry(id);
+    if (entry.refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        Touch(entry); // Unreferenced from now on; evicted in the order this happened
+}
+
+void TextureManager::Touch(Entry &entry)
+{
+    entry.lastUsed.store(useClock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
 
-    // Load the texture from file
+bool TextureManager::MountArchive(const std::string &path)
+{
+    // Surfaces waiting for upload may point into the current mapping
+    if (pendingCount > 0)
+    {
+        SDL_Log("Cannot mount %s while textures are loading", path.c_str());
+        return false;
+    }
+    if (!archive.Open(path))
+        return false;
+    SDL_Log("Mounted asset archive %s (%u assets)", path.c_str(), archive.GetEntryCount());
+    return true;
+}
+
+const AssetArchive &TextureManager::GetArchive() const { return archive; }
+
+SDL_Surface *TextureManager::Open(const std::string &path) const
+{
+    if (const ArchiveEntry *packed = archive.Find(path))
+        return archive.CreateSurface(*packed);
+    return Decode(path);
+}
+
+SDL_Surface *TextureManager::Decode(const std::string &path)
+{
     SDL_Surface *surface = SDL_LoadBMP(path.c_str());
     if (!surface)
     {
         SDL_Log("Failed to load BMP: %s", SDL_GetError());
         return nullptr;
     }
+    // Convert here, off the render thread, so the upload is a straight copy
+    SDL_Surface *converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+    SDL_DestroySurface(surface);
+    if (!converted)
+        SDL_Log("Failed to convert %s: %s", path.c_str(), SDL_GetError());
+    return converted;
+}
 
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+Uint32 TextureManager::AddEntry(const std::string &path)
+{
+    Uint32 id;
+    if (!freeIds.empty())
+    {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    else
+    {
+        id = GetEntryCount();
+        if (id == TEXTURE_ENTRY_CHUNK_SIZE * TEXTURE_ENTRY_CHUNKS)
+        {
+            SDL_Log("Cannot load %s: too many textures", path.c_str());
+            return 0;
+        }
+        // Publish the slot only once it exists, since handles on other threads index it
+        if ((id & TEXTURE_ENTRY_CHUNK_MASK) == 0)
+            AddChunk();
+        entryCount.store(id + 1, std::memory_order_release);
+    }
+    Entry &entry = GetEntry(id);
+    entry.path = path;
+    entry.status = TextureStatus::Loading;
+    entry.request = ++requests;
+    Touch(entry);
+    textureCache[path] = id;
+    ++pendingCount;
+    ++misses;
+    return id;
+}
+
+void TextureManager::Upload(Uint32 id, SDL_Surface *surface, SDL_Renderer *renderer)
+{
+    Entry &entry = GetEntry(id);
+    entry.job.reset();
+    --pendingCount;
+    entry.status = TextureStatus::Failed;
+    if (!surface)
+    {
+        failedIds.push_back(id);
+        return;
+    }
+
+    // Pack into the atlas; images too large for a page get a texture of their own. Before the
+    // GPU memory grows, evict down to the budget and try the space that freed up.
+    TextureRegion region;
+    size_t bytes = static_cast<size_t>(surface->w) * surface->h * sizeof(Uint32);
+    bool standalone = !atlas.Fits(surface->w, surface->h);
+    if (!standalone && !atlas.Add(surface, renderer, region, false))
+    {
+        EnforceBudget(atlas.GetPageByteSize());
+        standalone = !atlas.Add(surface, renderer, region);
+    }
+    if (standalone)
+    {
+        EnforceBudget(bytes);
+        SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+        if (!texture)
+        {
+            SDL_Log("Failed to create texture: %s", SDL_GetError());
+            SDL_DestroySurface(surface);
+            failedIds.push_back(id);
+            return;
+        }
+        standaloneBytes += bytes;
+        region.texture = texture;
+        region.src = { 0.0f, 0.0f, static_cast<float>(surface->w), static_cast<float>(surface->h) };
+    }
     SDL_DestroySurface(surface);
+    entry.region = region;
+    entry.bytes = bytes;
+    entry.standalone = standalone;
+    entry.status = TextureStatus::Ready;
+    residentBytes += bytes;
+    ++residentTextures;
+    EnforceBudget();
+}
 
-    if (!texture)
+void TextureManager::Unload(Entry &entry)
+{
+    if (entry.status == TextureStatus::Ready)
     {
-        SDL_Log("Failed to create texture: %s", SDL_GetError());
-        return nullptr;
+        if (entry.standalone)
+        {
+            SDL_DestroyTexture(entry.region.texture);
+            standaloneBytes -= entry.bytes;
+        }
+        else
+            atlas.Release(entry.region);
+        residentBytes -= entry.bytes;
+        --residentTextures;
     }
+    entry.region = {};
+    entry.bytes = 0;
+    entry.standalone = false;
+    entry.status = TextureStatus::Failed;
+}
+
+void TextureManager::FreeEntry(Uint32 id)
+{
+    Entry &entry = GetEntry(id);
+    auto it = textureCache.find(entry.path);
+    if (it != textureCache.end() && it->second == id)
+        textureCache.erase(it);
+    entry.path.clear();
+    entry.job.reset();
+    freeIds.push_back(id);
+}
 
-    // Cache the texture
-    textureCache[path] = texture;
-    return texture;
+void TextureManager::FreeFailed()
+{
+    // Only the main thread takes new references to an unreferenced entry, so 0 stays 0 here
+    failedIds.erase(std::remove_if(failedIds.begin(), failedIds.end(), [this](Uint32 id)
+    {
+        if (GetEntry(id).refCount.load(std::memory_order_acquire) > 0)
+            return false;
+        FreeEntry(id);
+        return true;
+    }), failedIds.end());
+}
+
+void TextureManager::EnforceBudget(size_t incoming)
+{
+    if (GetGpuBytes() + incoming <= budgetBytes)
+        return;
+
+    // Only textures nobody holds a handle to may go; referenced ones may exceed the budget
+    std::vector<Uint32> candidates;
+    for (Uint32 id = 1; id < GetEntryCount(); ++id)
+    {
+        const Entry &entry = GetEntry(id);
+        if (entry.status == TextureStatus::Ready && entry.refCount.load(std::memory_order_acquire) == 0)
+            candidates.push_back(id);
+    }
+    std::sort(candidates.begin(), candidates.end(), [this](Uint32 a, Uint32 b)
+    {
+        return GetEntry(a).lastUsed.load(std::memory_order_relaxed) < GetEntry(b).lastUsed.load(std::memory_order_relaxed);
+    });
+    for (size_t i = 0; i < candidates.size() && GetGpuBytes() + incoming > budgetBytes; ++i)
+    {
+        Unload(GetEntry(candidates[i]));
+        FreeEntry(candidates[i]);
+        ++evictions;
+    }
+}
+
+void TextureManager::CreatePlaceholder(SDL_Renderer *renderer)
+{
+    if (placeholder.texture || !renderer)
+        return;
+
+    // Magenta and dark grey checkerboard, hard to mistake for real art
+    SDL_Surface *surface = SDL_CreateSurface(PLACEHOLDER_SIZE, PLACEHOLDER_SIZE, SDL_PIXELFORMAT_RGBA32);
+    if (!surface)
+        return;
+    for (int y = 0; y < PLACEHOLDER_SIZE; ++y)
+    {
+        Uint8 *row = static_cast<Uint8 *>(surface->pixels) + y * surface->pitch;
+        for (int x = 0; x < PLACEHOLDER_SIZE; ++x)
+        {
+            bool light = ((x / PLACEHOLDER_CHECKER) + (y / PLACEHOLDER_CHECKER)) % 2 == 0;
+            Uint8 *pixel = row + x * 4; // RGBA32 is byte order R, G, B, A
+            pixel[0] = light ? 255 : 40;
+            pixel[1] = light ? 0 : 40;
+            pixel[2] = light ? 255 : 40;
+            pixel[3] = 255;
+        }
+    }
+    placeholder.texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (placeholder.texture)
+        placeholder.src = { 0.0f, 0.0f, static_cast<float>(PLACEHOLDER_SIZE), static_cast<float>(PLACEHOLDER_SIZE) };
+    else
+        SDL_Log("Failed to create placeholder texture: %s", SDL_GetError());
+    SDL_DestroySurface(surface);
 }
 
 void TextureManager::Clean()
 {
-    for (auto &pair : textureCache)
-        SDL_DestroyTexture(pair.second);
+    // Let in-flight decodes finish so no worker touches freed state
+    for (Uint32 id = 1; id < GetEntryCount(); ++id)
+        JobSystem::Instance().Wait(GetEntry(id).job);
+    inlineDecodes.clear();
+    {
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        uploadQueue.insert(uploadQueue.end(), decoded.begin(), decoded.end());
+        decoded.clear();
+    }
+    for (DecodedImage &image : uploadQueue)
+        SDL_DestroySurface(image.surface);
+    uploadQueue.clear();
+
+    // Entries still referenced keep their slot, so their handles stay safe to release later
+    freeIds.clear();
+    failedIds.clear();
+    for (Uint32 id = 1; id < GetEntryCount(); ++id)
+    {
+        Entry &entry = GetEntry(id);
+        Unload(entry);
+        entry.job.reset();
+        entry.path.clear();
+        if (entry.refCount.load(std::memory_order_acquire) == 0)
+            freeIds.push_back(id);
+    }
+    atlas.Clean();
+    if (placeholder.texture)
+        SDL_DestroyTexture(placeholder.texture);
+    placeholder = {};
     textureCache.clear();
+    pendingCount = 0;
+    standaloneBytes = 0;
 }
-
@@ -2,9 +2,45 @@
 #define TEXTUREMANAGER_HPP
 
 #include <SDL3/SDL.h>
+#include <atomic>
+#include <array>
+#include <mutex>
 #include <unordered_map>
 #include <string>
+#include <vector>
+#include "AssetArchive.hpp"
 #include "GameObject.hpp"
+#include "GameConfig.hpp"
+#include "JobSystem.hpp"
+#include "TextureAtlas.hpp"
+#include "TextureHandle.hpp"
+
+/**
+ * @enum TextureStatus
+ * @brief Where a texture is in its load.
+ */
+enum class TextureStatus
+{
+    Loading, // Queued, decoding on a worker, or waiting for its upload slot
+    Ready,   // Uploaded and drawable
+    Failed   // Could not be read, decoded or uploaded; draws as the placeholder
+};
+
+/**
+ * @struct TextureStats
+ * @brief TextureManager memory use and cache counters.
+ */
+struct TextureStats
+{
+    size_t residentBytes = 0; // Pixel bytes of all uploaded textures
+    size_t budgetBytes = 0;   // Eviction starts when gpuBytes would exceed this
+    size_t gpuBytes = 0;      // Actual GPU memory: atlas pages plus standalone textures
+    size_t textures = 0;      // Textures currently uploaded
+    size_t referenced = 0;    // Entries with at least one live handle
+    Uint64 hits = 0;          // Load requests answered from the cache
+    Uint64 misses = 0;        // Load requests that had to read the file
+    Uint64 evictions = 0;     // Textures evicted to stay under the budget
+};
 
 /**
  * @class TextureManager
@@ -13,12 +49,31 @@
  * The TextureManager class provides a centralized interface for loading textures from files,
  * caching them for efficient reuse, and releasing resources when they are no longer needed.
  * It ensures that each texture is loaded only once and reused throughout the application,
- * minimizing redundant resource usage. The class is implemented as a singleton to guarantee
- * a single point of management for all texture resources.
+ * minimizing redundant resource usage. Loaded images are packed into shared atlas pages, so
+ * many sprites can be drawn from one texture without switching. The class is implemented as a
+ * singleton to guarantee a single point of management for all texture resources.
+ *
+ * Textures are referred to by TextureHandle. LoadTextureAsync() hands one out immediately and
+ * reads and decodes the file on the JobSystem's workers; ProcessUploads(), called once per frame
+ * on the render thread, uploads finished images to the GPU within a byte budget. Until then the
+ * handle resolves to a small checkerboard placeholder, so scenes can be built and drawn without
+ * waiting for disk I/O.
+ *
+ * Handles are reference counted. Textures nobody holds a handle to stay cached, but when the GPU
+ * memory they take up (atlas pages plus textures of their own) would exceed the memory budget
+ * they are evicted, least recently used first, and a later request loads them again. An evicted
+ * image leaves room on its atlas page that later images are packed into before any new page is
+ * created, and a page is freed once all of its images are evicted. Only textures still
+ * referenced can take memory past the budget.
+ *
+ * When an asset archive is mounted, paths found in it are served from the mapped archive:
+ * the pre-decoded pixels are uploaded straight from the mapping, with no file read, decode or
+ * copy. Paths missing from the archive still load from disk.
  *
  * Usage:
  *   - Use TextureManager::Instance() to access the singleton instance.
- *   - Call LoadTexture() to load and retrieve textures.
+ *   - Call LoadTextureAsync() (or LoadTexture() to block until loaded) to get a handle.
+ *   - Call ProcessUploads() once per frame, and Resolve() a handle when drawing it.
  *   - Call Clean() to release all loaded textures and free associated resources.
  */
 class TextureManager 
@@ -33,34 +88,242 @@ class TextureManager
         /**
          * @brief Loads a texture from the specified file path using the given SDL renderer.
          *
-         * This function attempts to load an image file and create an SDL_Texture that can be used for rendering.
+         * This function loads an image file and packs it into the texture atlas before returning.
+         * Images larger than an atlas page are given a texture of their own. If the path is
+         * already streaming in, the load is finished now.
          *
          * @param path The file system path to the image file to load.
          * @param renderer The SDL_Renderer to use for creating the texture.
-         * @return A pointer to the loaded SDL_Texture, or nullptr if loading fails.
+         * @return Handle to the texture; its status is Failed if loading failed.
+         */
+        TextureHandle LoadTexture(const std::string &path, SDL_Renderer *renderer);
+
+        /**
+         * @brief Starts loading a texture in the background and returns its handle immediately.
+         *
+         * The file is read and decoded on a worker thread, or by ProcessUploads() when the
+         * JobSystem has no workers, then uploaded by a later ProcessUploads().
+         *
+         * @param path The file system path to the image file to load.
+         * @return Handle to the texture, drawn as the placeholder until it is ready.
+         */
+        TextureHandle LoadTextureAsync(const std::string &path);
+
+        /**
+         * @brief Uploads decoded images to the GPU. Call once per frame on the render thread.
+         *
+         * When the JobSystem has no workers, the decodes run here first, within the same budget.
+         *
+         * Images are uploaded in the order they were requested until @p byteBudget bytes of pixels
+         * have been uploaded; at least one image is uploaded per call so large images still arrive.
+         *
+         * @param renderer The SDL_Renderer to create textures with.
+         * @param byteBudget Pixel bytes to upload before deferring the rest to the next call.
+         * @return Number of textures that became ready.
+         */
+        size_t ProcessUploads(SDL_Renderer *renderer, size_t byteBudget);
+
+        /**
+         * @brief Blocks until every requested texture has been loaded and uploaded.
+         * @param renderer The SDL_Renderer to create textures with.
+         */
+        void FinishLoading(SDL_Renderer *renderer);
+
+        /**
+         * @brief Gets the region to draw for a handle: the texture if ready, else the placeholder.
+         */
+        const TextureRegion &Resolve(TextureHandle handle) const;
+
+        /**
+         * @brief Gets the load status of a texture.
+         */
+        TextureStatus GetStatus(TextureHandle handle) const;
+
+        /**
+         * @brief Gets the number of textures that are not ready or failed yet.
+         */
+        size_t GetPendingCount() const;
+
+        /**
+         * @brief Maps an asset archive; later loads of paths it contains read from it.
+         *
+         * Fails while any texture is still loading, since its pixels may point into the old archive.
+         * @param path Path of the .pak file written by Arrow2D_pack.
+         * @return true if the archive was mapped.
+         */
+        bool MountArchive(const std::string &path);
+
+        /**
+         * @brief Gets the mounted asset archive, for loading non-texture assets from it.
          */
-        SDL_Texture *LoadTexture(const std::string &path, SDL_Renderer *renderer);
+        const AssetArchive &GetArchive() const;
+
+        /**
+         * @brief Sets the memory budget and evicts unreferenced textures until under it.
+         * @param bytes GPU bytes allowed before unreferenced textures are evicted.
+         */
+        void SetBudget(size_t bytes);
+
+        /**
+         * @brief Gets memory use and cache hit/miss/eviction counters.
+         */
+        TextureStats GetStats() const;
 
         /**
          * @brief Releases all loaded textures and cleans up resources managed by the TextureManager.
          *
          * This function should be called to free memory and resources associated with textures
-         * before shutting down the application or when textures are no longer needed.
+         * before shutting down the application or when textures are no longer needed. Loads in
+         * flight are finished first. Handles that are still alive resolve to nothing afterwards.
          */
         void Clean();
 
     private:
+        friend class TextureHandle;
+
+        /// @brief Adds a reference to an entry. Called by TextureHandle, from any thread.
+        void AddRef(Uint32 id);
+
+        /// @brief Drops a reference to an entry. Called by TextureHandle, from any thread.
+        void Release(Uint32 id);
+
         /**
          * @brief Default constructor for the TextureManager class.
          *
          * Initializes a new instance of the TextureManager.
          * This constructor does not perform any specific initialization logic.
          */
-        TextureManager() = default;
-        
-        /// @brief A cache that maps texture file names (as strings) to their corresponding SDL_Texture pointers.
-        ///        This allows for efficient reuse and management of loaded textures within the application.
-        std::unordered_map<std::string, SDL_Texture *> textureCache; 
+        TextureManager();
+
+        /// @brief Frees the entry chunks.
+        ~TextureManager();
+
+        /// @brief State of one requested texture.
+        struct Entry
+        {
+            std::string path; // Empty while the slot is free
+            TextureRegion region;
+            TextureStatus status = TextureStatus::Loading;
+            JobHandle job; // Decode job while it may still be running
+            size_t bytes = 0; // Pixel bytes once uploaded
+            bool standalone = false; // Owns region.texture instead of sharing an atlas page
+            std::atomic<Uint32> refCount{ 0 };
+            std::atomic<Uint64> lastUsed{ 0 }; // Value of useClock when last requested or released
+            Uint64 request = 0; // Order the load was requested in, for uploads
+        };
+
+        /// @brief An image a worker has finished decoding, waiting for upload.
+        struct DecodedImage
+        {
+            Uint32 id;
+            SDL_Surface *surface; // RGBA32 pixels, or nullptr if decoding failed
+        };
+
+        /// @brief Reads an image and converts it to the atlas pixel format. Safe to call from any thread.
+        static SDL_Surface *Decode(const std::string &path);
+
+        /// @brief Gets a surface for a path: wrapping the archive's pixels if it has them, else decoded from disk.
+        SDL_Surface *Open(const std::string &path) const;
+
+        /// @brief Creates the entry for a path the cache has not seen.
+        Uint32 AddEntry(const std::string &path);
+
+        /**
+         * @brief Decodes the images queued for this thread, oldest request first, for when there are no workers.
+         *
+         * Stops once @p byteBudget bytes of pixels have been decoded; at least one image is decoded per call.
+         */
+        void DecodeInline(size_t byteBudget);
+
+        /// @brief Decodes (or waits for the decode of) one Loading entry and uploads it, leaving other loads queued.
+        void FinishLoading(Uint32 id, SDL_Renderer *renderer);
+
+        /// @brief Uploads a decoded image and marks its entry ready or failed. Takes ownership of @p surface.
+        void Upload(Uint32 id, SDL_Surface *surface, SDL_Renderer *renderer);
+
+        /// @brief Creates the placeholder texture if it does not exist yet.
+        void CreatePlaceholder(SDL_Renderer *renderer);
+
+        /// @brief Frees an entry's GPU memory and leaves it Failed.
+        void Unload(Entry &entry);
+
+        /// @brief Frees an unreferenced entry's slot so its ID can be reused.
+        void FreeEntry(Uint32 id);
+
+        /**
+         * @brief Evicts unreferenced textures, least recently used first, until the GPU memory in
+         * use plus @p incoming bytes is within the budget or nothing else can go.
+         */
+        void EnforceBudget(size_t incoming = 0);
+
+        /// @brief Gets the GPU memory of the atlas pages and standalone textures.
+        size_t GetGpuBytes() const { return atlas.GetByteSize() + standaloneBytes; }
+
+        /// @brief Marks an entry as just used, for LRU ordering.
+        void Touch(Entry &entry);
+
+        /// @brief Gets the entry for an ID below GetEntryCount(). Safe from any thread.
+        Entry &GetEntry(Uint32 id) const
+        {
+            return entryChunks[id >> TEXTURE_ENTRY_CHUNK_BITS].load(std::memory_order_acquire)[id & TEXTURE_ENTRY_CHUNK_MASK];
+        }
+
+        /// @brief Gets the number of entry slots in use or freed, including slot 0.
+        Uint32 GetEntryCount() const { return entryCount.load(std::memory_order_acquire); }
+
+        /// @brief Allocates the chunk the next slot falls in. Main thread only.
+        void AddChunk();
+
+        /// @brief Frees the slots of failed entries nobody holds a handle to any more.
+        void FreeFailed();
+
+        static constexpr Uint32 TEXTURE_ENTRY_CHUNK_BITS = 8;
+        static constexpr Uint32 TEXTURE_ENTRY_CHUNK_SIZE = 1u << TEXTURE_ENTRY_CHUNK_BITS;
+        static constexpr Uint32 TEXTURE_ENTRY_CHUNK_MASK = TEXTURE_ENTRY_CHUNK_SIZE - 1;
+        static constexpr Uint32 TEXTURE_ENTRY_CHUNKS = 4096; // Room for a million textures
+
+        /// @brief Every requested texture, in fixed-size chunks that never move, so handles on
+        /// other threads can update their counts while the main thread adds entries. Index 0 is
+        /// reserved so the default handle is empty.
+        std::array<std::atomic<Entry *>, TEXTURE_ENTRY_CHUNKS> entryChunks{};
+        std::atomic<Uint32> entryCount{ 0 };
+        std::vector<Uint32> freeIds; // Slots of evicted entries, reused before growing
+        std::vector<Uint32> failedIds; // Entries that failed to load, freed once unreferenced
+        Uint64 requests = 0; // Loads requested so far; stamps Entry::request
+
+        /// @brief Increases on every use; stamps lastUsed for LRU ordering.
+        std::atomic<Uint64> useClock{ 0 };
+
+        size_t budgetBytes = TEXTURE_MEMORY_BUDGET_BYTES;
+        size_t residentBytes = 0;
+        size_t residentTextures = 0;
+        Uint64 hits = 0;
+        Uint64 misses = 0;
+        Uint64 evictions = 0;
+
+        /// @brief A cache that maps texture file names to their entries, so each file is loaded once.
+        std::unordered_map<std::string, Uint32> textureCache; 
+
+        /// @brief Images decoded by workers, handed to the render thread under decodedMutex.
+        std::mutex decodedMutex;
+        std::vector<DecodedImage> decoded;
+        std::vector<DecodedImage> uploadQueue; // Decoded images waiting for upload budget, in request order
+        std::vector<Uint32> inlineDecodes; // Entries to decode on the render thread because there are no workers, in request order
+
+        size_t pendingCount = 0;
+
+        /// @brief Mapped archive that loads are served from first.
+        AssetArchive archive;
+
+        /// @brief Drawn in place of textures that are still loading or failed to load. A texture of
+        /// its own, so it never keeps an atlas page alive.
+        TextureRegion placeholder;
+
+        /// @brief Atlas pages holding every image that fits in one.
+        TextureAtlas atlas{ATLAS_PAGE_SIZE, ATLAS_PADDING};
+
+        /// @brief GPU bytes of textures for images too large for the atlas.
+        size_t standaloneBytes = 0;
 };
 
 #endif // TEXTUREMANAGER_HPP
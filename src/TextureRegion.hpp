@@ -0,0 +1,20 @@
+#ifndef TEXTUREREGION_HPP
+#define TEXTUREREGION_HPP
+
+#include <SDL3/SDL.h>
+
+/**
+ * @struct TextureRegion
+ * @brief A drawable image: a texture plus the rectangle of it that holds the image.
+ *
+ * Images loaded through the TextureManager are packed into shared atlas textures, so the
+ * source rectangle must always be passed along with the texture when drawing.
+ * A default-constructed region has no texture and is skipped by the renderer.
+ */
+struct TextureRegion
+{
+    SDL_Texture *texture = nullptr; // Atlas page (or standalone texture) containing the image
+    SDL_FRect src = { 0.0f, 0.0f, 0.0f, 0.0f }; // Image bounds inside the texture, in pixels
+};
+
+#endif // TEXTUREREGION_HPP
@@ -0,0 +1,344 @@
+#include "Tilemap.hpp"
+#include "Profiler.hpp"
+#include "Renderer.hpp"
+#include "TextureManager.hpp"
+#include <bitset>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+Tilemap::~Tilemap()
+{
+    Clean();
+}
+
+bool Tilemap::Load(const std::string &path)
+{
+    // Prefer the packed copy, read straight from the mapped archive
+    std::string text;
+    const AssetArchive &archive = TextureManager::Instance().GetArchive();
+    if (const ArchiveEntry *packed = archive.Find(path))
+        text.assign(static_cast<const char *>(archive.GetData(*packed)), packed->size);
+    else
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            SDL_Log("Failed to open tilemap %s", path.c_str());
+            Clean();
+            return false;
+        }
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        text = contents.str();
+    }
+    if (!Parse(text, path))
+    {
+        Clean();
+        return false;
+    }
+    return true;
+}
+
+bool Tilemap::Parse(const std::string &text, [[maybe_unused]] const std::string &path)
+{
+    int mapTileSize = 0, mapWidth = 0, mapHeight = 0;
+    std::string tilesetPath;
+    std::unordered_map<char, TileId> legend;
+    std::vector<TileId> solidIds;
+    std::vector<std::string> layerNames;
+    std::vector<std::vector<std::string>> layerRows;
+
+    std::istringstream in(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream fields(line);
+        std::string keyword;
+        fields >> keyword;
+        bool valid = true;
+        if (keyword == "tilesize")
+            valid = static_cast<bool>(fields >> mapTileSize) && mapTileSize > 0;
+        else if (keyword == "tileset")
+            valid = static_cast<bool>(fields >> tilesetPath);
+        else if (keyword == "size")
+            valid = static_cast<bool>(fields >> mapWidth >> mapHeight) && mapWidth > 0 && mapHeight > 0;
+        else if (keyword == "tile")
+        {
+            char symbol = 0;
+            int image = -1;
+            std::string flag;
+            valid = static_cast<bool>(fields >> symbol >> image) && image >= 0 && image < 0xFFFF
+                && symbol != '.' && (!(fields >> flag) || flag == "solid");
+            if (valid)
+            {
+                legend[symbol] = static_cast<TileId>(image + 1);
+                if (flag == "solid")
+                    solidIds.push_back(static_cast<TileId>(image + 1));
+            }
+        }
+        else if (keyword == "layer")
+        {
+            if (mapHeight <= 0)
+            {
+                SDL_Log("Tilemap %s:%d: layer before size", path.c_str(), lineNumber);
+                return false;
+            }
+            std::string name;
+            fields >> name;
+            layerNames.push_back(name);
+            layerRows.emplace_back();
+            // The rows are read as-is: '#' is a valid tile character inside a layer
+            for (int row = 0; row < mapHeight && std::getline(in, line); ++row)
+            {
+                ++lineNumber;
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                layerRows.back().push_back(line);
+            }
+            if (static_cast<int>(layerRows.back().size()) != mapHeight)
+            {
+                SDL_Log("Tilemap %s: layer %s has fewer than %d rows", path.c_str(), name.c_str(), mapHeight);
+                return false;
+            }
+        }
+        else
+            valid = false;
+        if (!valid)
+        {
+            SDL_Log("Tilemap %s:%d: cannot parse \"%s\"", path.c_str(), lineNumber, line.c_str());
+            return false;
+        }
+    }
+    if (mapTileSize <= 0 || mapWidth <= 0 || mapHeight <= 0)
+    {
+        SDL_Log("Tilemap %s: missing tilesize or size", path.c_str());
+        return false;
+    }
+
+    Create(mapWidth, mapHeight, mapTileSize, static_cast<int>(layerRows.size()), tilesetPath);
+    for (TileId id : solidIds)
+        SetSolid(id, true);
+    for (size_t l = 0; l < layerRows.size(); ++l)
+    {
+        layers[l].name = layerNames[l];
+        for (int ty = 0; ty < mapHeight; ++ty)
+        {
+            const std::string &row = layerRows[l][ty];
+            int columns = std::min(mapWidth, static_cast<int>(row.size()));
+            for (int tx = 0; tx < columns; ++tx)
+            {
+                char symbol = row[tx];
+                if (symbol == '.' || symbol == ' ')
+                    continue;
+                auto it = legend.find(symbol);
+                if (it == legend.end())
+                {
+                    SDL_Log("Tilemap %s: layer %s uses undeclared tile '%c'", path.c_str(), layerNames[l].c_str(), symbol);
+                    return false;
+                }
+                SetTile(static_cast<int>(l), tx, ty, it->second);
+            }
+        }
+    }
+    return true;
+}
+
+void Tilemap::Create(int width, int height, int tileSize, int layers, const std::string &tilesetPath)
+{
+    Clean();
+    this->width = std::max(0, width);
+    this->height = std::max(0, height);
+    this->tileSize = std::max(1, tileSize);
+    chunksX = (this->width + CHUNK - 1) / CHUNK;
+    chunksY = (this->height + CHUNK - 1) / CHUNK;
+    this->layers.resize(std::max(0, layers));
+    for (Layer &layer : this->layers)
+        layer.chunks.resize(static_cast<size_t>(chunksX) * chunksY);
+    wordsPerRow = (static_cast<size_t>(this->width) + 63) / 64;
+    solid.assign(wordsPerRow * this->height, 0);
+    if (!tilesetPath.empty())
+        tileset = TextureManager::Instance().LoadTextureAsync(tilesetPath);
+}
+
+void Tilemap::Clean()
+{
+    for (Chunk *chunk : cached)
+        SDL_DestroyTexture(chunk->texture);
+    cached.clear();
+    layers.clear();
+    solidTiles.clear();
+    solid.clear();
+    width = height = tileSize = 0;
+    chunksX = chunksY = 0;
+    wordsPerRow = 0;
+    tileset = TextureHandle();
+    bakes = 0;
+    drawnChunks = 0;
+}
+
+int Tilemap::FindLayer(const std::string &name) const
+{
+    for (size_t l = 0; l < layers.size(); ++l)
+    {
+        if (layers[l].name == name)
+            return static_cast<int>(l);
+    }
+    return -1;
+}
+
+TileId Tilemap::GetTile(int layer, int tx, int ty) const
+{
+    if (layer < 0 || layer >= GetLayerCount() || tx < 0 || ty < 0 || tx >= width || ty >= height)
+        return EMPTY_TILE;
+    const Chunk *chunk = layers[layer].chunks[static_cast<size_t>(ty / CHUNK) * chunksX + tx / CHUNK].get();
+    return chunk ? chunk->tiles[(ty % CHUNK) * CHUNK + tx % CHUNK] : EMPTY_TILE;
+}
+
+void Tilemap::SetTile(int layer, int tx, int ty, TileId tile)
+{
+    if (layer < 0 || layer >= GetLayerCount() || tx < 0 || ty < 0 || tx >= width || ty >= height)
+        return;
+    std::unique_ptr<Chunk> &chunk = layers[layer].chunks[static_cast<size_t>(ty / CHUNK) * chunksX + tx / CHUNK];
+    if (!chunk)
+    {
+        if (tile == EMPTY_TILE)
+            return;
+        chunk = std::make_unique<Chunk>();
+    }
+    TileId &slot = chunk->tiles[(ty % CHUNK) * CHUNK + tx % CHUNK];
+    if (slot == tile)
+        return;
+    slot = tile;
+    chunk->dirty = true;
+    UpdateSolid(tx, ty);
+}
+
+void Tilemap::SetSolid(TileId tile, bool isSolid)
+{
+    if (tile == EMPTY_TILE)
+        return;
+    if (tile >= solidTiles.size())
+        solidTiles.resize(static_cast<size_t>(tile) + 1, false);
+    solidTiles[tile] = isSolid;
+}
+
+void Tilemap::UpdateSolid(int tx, int ty)
+{
+    bool blocked = false;
+    for (int l = 0; l < GetLayerCount() && !blocked; ++l)
+        blocked = IsSolidTile(GetTile(l, tx, ty));
+    Uint64 &word = solid[static_cast<size_t>(ty) * wordsPerRow + (tx >> 6)];
+    Uint64 bit = Uint64(1) << (tx & 63);
+    word = blocked ? (word | bit) : (word & ~bit);
+}
+
+bool Tilemap::Bake(Renderer &renderer, Chunk &chunk, const TextureRegion &tiles)
+{
+    const int chunkPixels = CHUNK * tileSize;
+    if (!chunk.texture)
+    {
+        chunk.texture = renderer.CreateLayerTexture(chunkPixels, chunkPixels);
+        if (!chunk.texture)
+            return false;
+        cached.push_back(&chunk);
+    }
+
+    SDL_Renderer *sdlRenderer = renderer.GetSDLRenderer();
+    bool baked = renderer.BeginLayerBake(chunk.texture);
+    const float size = static_cast<float>(tileSize);
+    const int columns = std::max(1, static_cast<int>(tiles.src.w) / tileSize);
+    for (int i = 0; baked && i < CHUNK * CHUNK; ++i)
+    {
+        TileId tile = chunk.tiles[i];
+        if (tile == EMPTY_TILE)
+            continue;
+        int image = tile - 1;
+        SDL_FRect src = { tiles.src.x + (image % columns) * size, tiles.src.y + (image / columns) * size, size, size };
+        SDL_FRect dest = { (i % CHUNK) * size, (i / CHUNK) * size, size, size };
+        SDL_RenderTexture(sdlRenderer, tiles.texture, &src, &dest);
+    }
+    renderer.EndLayerBake();
+    if (!baked)
+        return false;
+    chunk.dirty = false;
+    ++bakes;
+    return true;
+}
+
+void Tilemap::Render(Renderer &renderer, const SDL_FRect &camera)
+{
+    PROFILE_ZONE("Tilemap::Render");
+    ++frame;
+    drawnChunks = 0;
+    TextureManager &textures = TextureManager::Instance();
+    // Chunks are only drawn from the real tileset, never baked from its placeholder
+    if (!IsLoaded() || !renderer.GetSDLRenderer() || textures.GetStatus(tileset) != TextureStatus::Ready)
+        return;
+    const TextureRegion &tiles = textures.Resolve(tileset);
+
+    const float chunkSize = static_cast<float>(CHUNK * tileSize);
+    int cx0 = std::max(0, static_cast<int>(std::floor(camera.x / chunkSize)));
+    int cy0 = std::max(0, static_cast<int>(std::floor(camera.y / chunkSize)));
+    int cx1 = std::min(chunksX - 1, static_cast<int>(std::floor((camera.x + camera.w) / chunkSize)));
+    int cy1 = std::min(chunksY - 1, static_cast<int>(std::floor((camera.y + camera.h) / chunkSize)));
+    for (int l = 0; l < GetLayerCount(); ++l)
+    {
+        Layer &layer = layers[l];
+        for (int cy = cy0; cy <= cy1; ++cy)
+        {
+            for (int cx = cx0; cx <= cx1; ++cx)
+            {
+                Chunk *chunk = layer.chunks[static_cast<size_t>(cy) * chunksX + cx].get();
+                if (!chunk)
+                    continue;
+                if ((chunk->dirty || !chunk->texture) && !Bake(renderer, *chunk, tiles))
+                    continue;
+                chunk->lastDrawn = frame;
+                SDL_FRect dest = { cx * chunkSize - camera.x, cy * chunkSize - camera.y, chunkSize, chunkSize };
+                renderer.RenderTexture(TextureRegion{ chunk->texture, { 0.0f, 0.0f, chunkSize, chunkSize } }, dest, TILEMAP_DRAW_LAYER + l);
+                ++drawnChunks;
+            }
+        }
+    }
+    TrimCache();
+}
+
+void Tilemap::TrimCache()
+{
+    if (cached.size() <= TILEMAP_CHUNK_CACHE)
+        return;
+    // Oldest first; chunks drawn this frame are still queued in the renderer and must survive
+    std::sort(cached.begin(), cached.end(), [](const Chunk *a, const Chunk *b) { return a->lastDrawn < b->lastDrawn; });
+    size_t excess = cached.size() - TILEMAP_CHUNK_CACHE;
+    size_t evicted = 0;
+    while (evicted < excess && cached[evicted]->lastDrawn != frame)
+    {
+        SDL_DestroyTexture(cached[evicted]->texture);
+        cached[evicted]->texture = nullptr;
+        ++evicted;
+    }
+    cached.erase(cached.begin(), cached.begin() + evicted);
+}
+
+TilemapStats Tilemap::GetStats() const
+{
+    TilemapStats stats;
+    for (const Layer &layer : layers)
+    {
+        for (const std::unique_ptr<Chunk> &chunk : layer.chunks)
+            stats.chunks += chunk ? 1 : 0;
+    }
+    for (Uint64 word : solid)
+        stats.solidTiles += std::bitset<64>(word).count();
+    stats.cachedChunks = cached.size();
+    stats.bakes = bakes;
+    stats.drawnChunks = drawnChunks;
+    return stats;
+}
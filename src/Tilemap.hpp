@@ -0,0 +1,248 @@
+#ifndef TILEMAP_HPP
+#define TILEMAP_HPP
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GameConfig.hpp"
+#include "TextureHandle.hpp"
+#include "TextureRegion.hpp"
+
+class Renderer;
+
+/// @brief Tile in a layer: 0 is empty, n is image n - 1 of the tileset.
+using TileId = Uint16;
+
+/// @brief The empty tile.
+constexpr TileId EMPTY_TILE = 0;
+
+/**
+ * @struct TilemapStats
+ * @brief Tilemap size and chunk texture cache counters.
+ */
+struct TilemapStats
+{
+    size_t chunks = 0;        // Non-empty chunks over all layers
+    size_t solidTiles = 0;    // Tiles set in the collision bitset
+    size_t cachedChunks = 0;  // Chunk textures currently held
+    Uint64 bakes = 0;         // Chunk textures drawn since loading
+    size_t drawnChunks = 0;   // Chunks drawn by the last Render()
+};
+
+/**
+ * @class Tilemap
+ * @brief Static level geometry: layers of tiles drawn from one tileset, plus a collision bitset.
+ *
+ * Each layer is split into square chunks of TILEMAP_CHUNK_TILES tiles a side. Chunks that are
+ * entirely empty are not stored, so sparse levels cost little memory. When a chunk comes into
+ * view its tiles are drawn once into a texture of its own, and from then on the chunk is a
+ * single sprite until one of its tiles changes. At most TILEMAP_CHUNK_CACHE chunk textures are
+ * kept; the ones drawn least recently are released first and re-drawn when needed again.
+ *
+ * Collision is one bit per tile, set where any layer holds a solid tile. Whether a tile is solid
+ * is a property of its TileId, declared in the map file. Checking a tile is a single bit test,
+ * so a mover pays only for the tiles its path touches, however large the level is.
+ *
+ * The map covers the world from (0, 0) to (width * tileSize, height * tileSize).
+ *
+ * Map files are text. A header of keyword lines is followed by one block per layer; outside
+ * the layer rows, blank lines and lines starting with '#' are skipped:
+ * @code
+ * # Tile width and height in pixels, tileset image, and map width and height in tiles
+ * tilesize 32
+ * tileset assets/sprites/Tiles/tiles.bmp
+ * size 8 2
+ * # Legend: character, tileset image (0-based, left to right, top to bottom), optional "solid"
+ * tile , 0
+ * tile # 1 solid
+ * # "layer <name>" is followed by exactly one line per tile row, read as-is. '.' and ' ' are
+ * # empty, and short rows are padded with empty tiles.
+ * layer ground
+ * ,,,,,,,,
+ * ,,,,,,,,
+ * layer walls
+ * ########
+ * #......#
+ * @endcode
+ */
+class Tilemap
+{
+    public:
+        /**
+         * @brief Destroys the chunk textures.
+         */
+        ~Tilemap();
+
+        /**
+         * @brief Loads a map file, replacing the current map.
+         *
+         * The copy in the mounted asset archive is used when there is one. The tileset streams
+         * in through TextureManager; chunks are drawn once it is ready.
+         *
+         * @param path Path of the map file.
+         * @return true on success. On failure the map is left empty and the reason is logged.
+         */
+        bool Load(const std::string &path);
+
+        /**
+         * @brief Replaces the map with an empty one, for building levels in code.
+         * @param width Width in tiles.
+         * @param height Height in tiles.
+         * @param tileSize Tile width and height in pixels.
+         * @param layers Number of layers.
+         * @param tilesetPath Tileset image, or empty for a map that is never drawn.
+         */
+        void Create(int width, int height, int tileSize, int layers, const std::string &tilesetPath = "");
+
+        /**
+         * @brief Destroys the chunk textures and empties the map.
+         */
+        void Clean();
+
+        /**
+         * @brief Checks if a map is loaded.
+         */
+        bool IsLoaded() const { return width > 0 && height > 0; }
+
+        int GetWidth() const { return width; }
+        int GetHeight() const { return height; }
+        int GetTileSize() const { return tileSize; }
+        int GetLayerCount() const { return static_cast<int>(layers.size()); }
+        const TextureHandle &GetTileset() const { return tileset; }
+
+        /**
+         * @brief Finds a layer by the name given in the map file.
+         * @return The layer index, or -1 if there is no such layer.
+         */
+        int FindLayer(const std::string &name) const;
+
+        /**
+         * @brief Gets a tile, or EMPTY_TILE outside the map.
+         */
+        TileId GetTile(int layer, int tx, int ty) const;
+
+        /**
+         * @brief Sets a tile, updating the collision bitset and marking its chunk for redrawing.
+         */
+        void SetTile(int layer, int tx, int ty, TileId tile);
+
+        /**
+         * @brief Declares whether a tile ID blocks movement. Call before placing tiles.
+         */
+        void SetSolid(TileId tile, bool solid);
+
+        /**
+         * @brief Checks if a tile position is blocked in any layer. Outside the map is never solid.
+         */
+        bool IsSolid(int tx, int ty) const
+        {
+            if (tx < 0 || ty < 0 || tx >= width || ty >= height)
+                return false;
+            return (solid[static_cast<size_t>(ty) * wordsPerRow + (tx >> 6)] >> (tx & 63)) & 1;
+        }
+
+        /**
+         * @brief Calls @p fn with the world rectangle of every solid tile overlapping @p area.
+         *
+         * Tiles are visited row by row, left to right. Cost is one bit test per tile the area
+         * covers, with whole empty 64-tile words skipped at once.
+         *
+         * @param area World-space rectangle to search.
+         * @param fn Called as fn(const SDL_FRect&).
+         */
+        template <typename Fn>
+        void ForEachSolidTile(const SDL_FRect &area, Fn &&fn) const;
+
+        /**
+         * @brief Draws the visible chunks of every layer, drawing chunk textures first where needed.
+         *
+         * Layer i is submitted on draw layer TILEMAP_DRAW_LAYER + i, below the scene's sprites.
+         *
+         * @param renderer The renderer to draw with.
+         * @param camera Visible world-space rectangle.
+         */
+        void Render(Renderer &renderer, const SDL_FRect &camera);
+
+        /**
+         * @brief Gets the map size and chunk cache counters.
+         */
+        TilemapStats GetStats() const;
+
+    private:
+        static constexpr int CHUNK = TILEMAP_CHUNK_TILES;
+
+        /// @brief One CHUNK x CHUNK block of a layer, with its cached texture.
+        struct Chunk
+        {
+            std::array<TileId, CHUNK * CHUNK> tiles = {};
+            SDL_Texture *texture = nullptr; // Baked tiles, or nullptr when not cached
+            bool dirty = true;              // Tiles changed since the texture was drawn
+            Uint64 lastDrawn = 0;           // Frame the chunk was last drawn, for cache eviction
+        };
+
+        struct Layer
+        {
+            std::string name;
+            std::vector<std::unique_ptr<Chunk>> chunks; // chunksX * chunksY, nullptr while empty
+        };
+
+        /// @brief Parses map text. Returns false and logs on a malformed file.
+        bool Parse(const std::string &text, const std::string &path);
+
+        /// @brief Checks if a tile ID was declared solid.
+        bool IsSolidTile(TileId tile) const { return tile < solidTiles.size() && solidTiles[tile]; }
+
+        /// @brief Recomputes one tile's collision bit from every layer.
+        void UpdateSolid(int tx, int ty);
+
+        /// @brief Draws a chunk's tiles into its texture, creating it if needed.
+        bool Bake(Renderer &renderer, Chunk &chunk, const TextureRegion &tiles);
+
+        /// @brief Releases the least recently drawn chunk textures until the cache fits.
+        void TrimCache();
+
+        int width = 0, height = 0, tileSize = 0;
+        int chunksX = 0, chunksY = 0;
+        std::vector<Layer> layers;
+        std::vector<bool> solidTiles; // Indexed by TileId
+        std::vector<Uint64> solid;    // Collision bitset, row-major, wordsPerRow words per tile row
+        size_t wordsPerRow = 0;
+        TextureHandle tileset;
+        std::vector<Chunk *> cached; // Chunks holding a texture
+        Uint64 frame = 0;
+        Uint64 bakes = 0;
+        size_t drawnChunks = 0;
+};
+
+template <typename Fn>
+void Tilemap::ForEachSolidTile(const SDL_FRect &area, Fn &&fn) const
+{
+    if (!IsLoaded())
+        return;
+    const float size = static_cast<float>(tileSize);
+    int tx0 = std::max(0, static_cast<int>(std::floor(area.x / size)));
+    int ty0 = std::max(0, static_cast<int>(std::floor(area.y / size)));
+    int tx1 = std::min(width - 1, static_cast<int>(std::floor((area.x + area.w) / size)));
+    int ty1 = std::min(height - 1, static_cast<int>(std::floor((area.y + area.h) / size)));
+    for (int ty = ty0; ty <= ty1; ++ty)
+    {
+        const Uint64 *row = &solid[static_cast<size_t>(ty) * wordsPerRow];
+        for (int tx = tx0; tx <= tx1; ++tx)
+        {
+            Uint64 word = row[tx >> 6];
+            if (word == 0)
+            {
+                tx |= 63; // Skip the rest of an empty word
+                continue;
+            }
+            if ((word >> (tx & 63)) & 1)
+                fn(SDL_FRect{ tx * size, ty * size, size, size });
+        }
+    }
+}
+
+#endif // TILEMAP_HPP
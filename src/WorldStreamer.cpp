@@ -0,0 +1,193 @@
+#include "WorldStreamer.hpp"
+#include "GameConfig.hpp"
+#include "Profiler.hpp"
+#include "Scene.hpp"
+#include "TextureManager.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    SDL_FRect Expand(const SDL_FRect& rect, float margin)
+    {
+        return { rect.x - margin, rect.y - margin, rect.w + 2 * margin, rect.h + 2 * margin };
+    }
+}
+
+bool WorldStreamer::Load(const std::string& path)
+{
+    // Prefer the packed copy, read straight from the mapped archive
+    std::string text;
+    const AssetArchive& archive = TextureManager::Instance().GetArchive();
+    if (const ArchiveEntry* packed = archive.Find(path))
+        text.assign(static_cast<const char*>(archive.GetData(*packed)), packed->size);
+    else
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            SDL_Log("Failed to open world %s", path.c_str());
+            return false;
+        }
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        text = contents.str();
+    }
+
+    regions.clear();
+    std::istringstream in(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        std::istringstream fields(line);
+        std::string keyword;
+        if (!(fields >> keyword) || keyword[0] == '#')
+            continue;
+        bool valid = true;
+        if (keyword == "regionsize")
+        {
+            float size = 0.0f;
+            valid = static_cast<bool>(fields >> size) && size > 0.0f;
+            if (valid)
+                SetRegionSize(size);
+        }
+        else if (keyword == "region")
+        {
+            int x, y;
+            std::string scenePath;
+            valid = static_cast<bool>(fields >> x >> y >> scenePath);
+            if (valid)
+                AddRegion(x, y, scenePath);
+        }
+        else
+            valid = false;
+        if (!valid)
+        {
+            SDL_Log("World %s:%d: cannot parse \"%s\"", path.c_str(), lineNumber, line.c_str());
+            regions.clear();
+            return false;
+        }
+    }
+    stats = {};
+    stats.regions = regions.size();
+    return true;
+}
+
+void WorldStreamer::AddRegion(int x, int y, const std::string& path)
+{
+    auto it = std::find_if(regions.begin(), regions.end(), [&](const Region& r) { return r.x == x && r.y == y; });
+    if (it == regions.end())
+    {
+        regions.emplace_back();
+        it = regions.end() - 1;
+        it->x = x;
+        it->y = y;
+    }
+    it->path = path;
+    stats.regions = regions.size();
+}
+
+void WorldStreamer::SetRegionSize(float size)
+{
+    regionSize = size;
+}
+
+void WorldStreamer::Clear(Scene& scene)
+{
+    for (Region& region : regions)
+        Unload(scene, region);
+    regions.clear();
+    stats = {};
+}
+
+void WorldStreamer::SetSynchronous(bool synchronous)
+{
+    this->synchronous = synchronous;
+}
+
+void WorldStreamer::StartReading(Region& region)
+{
+    // The job keeps the file alive, so the region may be dropped while it is still being read
+    std::shared_ptr<PendingFile> pending = std::make_shared<PendingFile>();
+    std::string path = region.path;
+    region.pending = pending;
+    region.job = JobSystem::Instance().Schedule([pending, path]() { pending->loaded = pending->file.Load(path); });
+    region.state = RegionState::Reading;
+}
+
+void WorldStreamer::Unload(Scene& scene, Region& region)
+{
+    SceneFile::Remove(scene, region.instance);
+    region.job.reset();
+    region.pending.reset();
+    region.state = RegionState::Unloaded;
+}
+
+void WorldStreamer::Stream(Scene& scene, const SDL_FRect& camera)
+{
+    PROFILE_ZONE("WorldStreamer::Stream");
+    const SDL_FRect loadArea = Expand(camera, WORLD_LOAD_MARGIN);
+    const SDL_FRect keepArea = Expand(camera, WORLD_UNLOAD_MARGIN);
+    // Without workers a job only runs when waited on
+    const bool wait = synchronous || JobSystem::Instance().GetWorkerCount() == 0;
+    size_t budget = synchronous ? SIZE_MAX : WORLD_SPAWN_BUDGET;
+    stats.created = 0;
+    stats.removed = 0;
+
+    for (Region& region : regions)
+    {
+        SDL_FRect bounds = { region.x * regionSize, region.y * regionSize, regionSize, regionSize };
+        if (region.state == RegionState::Unloaded)
+        {
+            if (!GameObject::Intersects(bounds, loadArea))
+                continue;
+            StartReading(region);
+        }
+        else if (!GameObject::Intersects(bounds, keepArea))
+        {
+            Unload(scene, region);
+            ++stats.removed;
+            continue;
+        }
+
+        if (region.state == RegionState::Reading)
+        {
+            if (wait)
+                JobSystem::Instance().Wait(region.job);
+            if (!region.job->done.load(std::memory_order_acquire))
+                continue;
+            region.job.reset();
+            // A file that failed to load leaves the region empty; it is not retried
+            region.state = region.pending->loaded ? RegionState::Building : RegionState::Loaded;
+        }
+
+        if (region.state == RegionState::Building && budget > 0)
+        {
+            size_t before = region.instance.objects.size() + region.instance.sprites.size();
+            bool complete = region.pending->file.InstantiateSome(scene, region.instance, budget);
+            size_t created = region.instance.objects.size() + region.instance.sprites.size() - before;
+            budget -= std::min(budget, created);
+            stats.created += created;
+            if (complete)
+            {
+                // Everything needed to remove the region is in its instance
+                region.pending.reset();
+                region.state = RegionState::Loaded;
+            }
+        }
+    }
+
+    stats.reading = stats.building = stats.loaded = stats.objects = 0;
+    for (const Region& region : regions)
+    {
+        stats.reading += region.state == RegionState::Reading;
+        stats.building += region.state == RegionState::Building;
+        stats.loaded += region.state == RegionState::Loaded;
+        stats.objects += region.instance.objects.size();
+    }
+}
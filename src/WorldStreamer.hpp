@@ -0,0 +1,145 @@
+#ifndef WORLDSTREAMER_HPP
+#define WORLDSTREAMER_HPP
+
+#include <SDL3/SDL.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "JobSystem.hpp"
+#include "SceneFile.hpp"
+
+class Scene;
+
+/**
+ * @struct WorldStats
+ * @brief Region counts and the objects they hold, from the most recent Stream().
+ */
+struct WorldStats
+{
+    size_t regions = 0;  // Regions in the world
+    size_t reading = 0;  // Regions whose file is being read on a worker
+    size_t building = 0; // Regions being created a few objects per frame
+    size_t loaded = 0;   // Regions fully created
+    size_t objects = 0;  // Objects in the scene that belong to regions
+    size_t created = 0;  // Objects and sprites created by the last Stream()
+    size_t removed = 0;  // Regions removed by the last Stream()
+};
+
+/**
+ * @class WorldStreamer
+ * @brief Loads the regions of a large world around the camera and removes them again behind it.
+ *
+ * The world is split into square regions of a fixed size, each described by a scene file of
+ * its own. A region starts loading once it is within WORLD_LOAD_MARGIN of the camera: its file
+ * is read on the JobSystem, then its objects and static sprites are created a few at a time,
+ * within WORLD_SPAWN_BUDGET per step over all regions. It is removed, with the texture
+ * references it holds, once it is further than WORLD_UNLOAD_MARGIN away. The gap between the
+ * two margins keeps a camera moving back and forth over a region border from reloading it
+ * every frame. Memory and update cost therefore follow the area around the camera, not the
+ * size of the world.
+ *
+ * Objects belong to the region they were created with, wherever they have moved to since, and
+ * leave with it. Tilemaps named by region files are ignored.
+ *
+ * World files are text, in the same style as map files:
+ * @code
+ * # Width and height of every region in pixels
+ * regionsize 2048
+ * # region <x> <y> <scene file>: region (x, y) covers [x * size, (x + 1) * size) horizontally
+ * region 0 0 assets/world/Region_0_0.scene
+ * region 1 0 assets/world/Region_1_0.scn
+ * @endcode
+ */
+class WorldStreamer
+{
+    public:
+        /**
+         * @brief Replaces the world with one read from a world file. Nothing is loaded until Stream().
+         *
+         * The copy in the mounted asset archive is used when there is one. Call Clear() first if
+         * regions of a previous world are loaded.
+         *
+         * @param path Path of the world file.
+         * @return true on success; errors are logged with their line number.
+         */
+        bool Load(const std::string& path);
+
+        /**
+         * @brief Adds a region to the world, replacing any region already at (x, y).
+         */
+        void AddRegion(int x, int y, const std::string& path);
+
+        /**
+         * @brief Sets the width and height of every region, in pixels. Call before adding regions.
+         */
+        void SetRegionSize(float size);
+
+        /**
+         * @brief Removes every loaded region from the scene and forgets the world.
+         */
+        void Clear(Scene& scene);
+
+        /**
+         * @brief Loads regions near @p camera and removes those far from it. Call once per step on
+         * the main thread, after the scene's objects have moved; Scene::Update() does so at its end.
+         */
+        void Stream(Scene& scene, const SDL_FRect& camera);
+
+        /**
+         * @brief Makes every region near the camera load completely within the Stream() call that
+         * first sees it, so what is loaded when no longer depends on disk or thread timing.
+         *
+         * Used by input recording and replay, whose runs must simulate the same objects.
+         */
+        void SetSynchronous(bool synchronous);
+
+        /**
+         * @brief Checks if the world has any regions.
+         */
+        bool IsEmpty() const { return regions.empty(); }
+
+        /**
+         * @brief Gets the counters from the most recent Stream().
+         */
+        const WorldStats& GetStats() const { return stats; }
+
+    private:
+        /// @brief Where a region is in its life cycle.
+        enum class RegionState
+        {
+            Unloaded,
+            Reading,  // The file is being read by a job
+            Building, // Objects are being created
+            Loaded
+        };
+
+        /// @brief A region file read by a job. Shared with the job so it can outlive the region.
+        struct PendingFile
+        {
+            SceneFile file;
+            bool loaded = false;
+        };
+
+        struct Region
+        {
+            int x = 0, y = 0; // Region coordinates
+            std::string path;
+            RegionState state = RegionState::Unloaded;
+            JobHandle job;
+            std::shared_ptr<PendingFile> pending;
+            SceneInstance instance;
+        };
+
+        /// @brief Starts reading a region's file.
+        void StartReading(Region& region);
+
+        /// @brief Removes whatever a region has created and drops its file.
+        void Unload(Scene& scene, Region& region);
+
+        float regionSize = 2048.0f;
+        bool synchronous = false;
+        std::vector<Region> regions; // In file order, which is the order they are streamed in
+        WorldStats stats;
+};
+
+#endif // WORLDSTREAMER_HPP
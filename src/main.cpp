@@ -1,16 +1,89 @@
 #include <iostream>
+#include <string>
+#include <cstdlib>
 #include "Engine.hpp"
+#include "Profiler.hpp"
 
-int main()
+int main(int argc, char *argv[])
 {
     Engine& engine = Engine::Instance();
 
-    if (!engine.Init("My Game", 1440, 810))
+    // "--headless N" runs N frames offscreen and prints timings instead of opening a window
+    // "--trace PATH" writes the profiler's zones as a Chrome trace on exit
+    // "--record PATH" saves every simulation step's input on exit
+    // "--replay PATH" replays a recording headless and checks the scene against it
+    int headlessFrames = 0;
+    std::string tracePath, recordPath, replayPath;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--headless")
+            headlessFrames = (i + 1 < argc) ? std::atoi(argv[++i]) : 600;
+        else if (arg == "--trace" && i + 1 < argc)
+            tracePath = argv[++i];
+        else if (arg == "--record" && i + 1 < argc)
+            recordPath = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc)
+            replayPath = argv[++i];
+    }
+
+    if (!engine.Init("My Game", 1440, 810, headlessFrames > 0 || !replayPath.empty()))
     {
         std::cerr << "Failed to initialize the engine." << std::endl;
         return -1;
     }
+    if (!replayPath.empty())
+    {
+        if (!engine.StartReplay(replayPath))
+        {
+            std::cerr << "Failed to load the replay." << std::endl;
+            engine.Clean();
+            return -1;
+        }
+        // One step per headless frame: run the whole recording unless told otherwise
+        if (headlessFrames <= 0)
+            headlessFrames = static_cast<int>(engine.GetReplayResult().ticks);
+    }
+    else if (!recordPath.empty())
+        engine.StartRecording();
+
+    if (headlessFrames > 0)
+    {
+        double total = 0.0, update = 0.0, render = 0.0;
+        std::vector<FrameTiming> timings = engine.RunFrames(headlessFrames);
+        for (const FrameTiming& t : timings)
+        {
+            total += t.totalMs;
+            update += t.updateMs;
+            render += t.renderMs;
+        }
+        size_t n = timings.empty() ? 1 : timings.size();
+        std::cout << timings.size() << " headless frames: " << total / n << " ms/frame (update "
+                  << update / n << " ms, render " << render / n << " ms)" << std::endl;
+    }
+    else
+        engine.Run();
+
+    if (!replayPath.empty())
+    {
+        ReplayResult replay = engine.GetReplayResult();
+        if (replay.mismatches == 0)
+            std::cout << "Replay: " << replay.replayed << " of " << replay.ticks << " steps match the recording" << std::endl;
+        else
+            std::cout << "Replay diverged at step " << replay.firstMismatch << ": " << replay.mismatches << " of "
+                      << replay.replayed << " steps differ from the recording" << std::endl;
+    }
+    else if (!recordPath.empty() && engine.SaveRecording(recordPath))
+        std::cout << "Wrote recording to " << recordPath << std::endl;
+
+    if (!tracePath.empty())
+    {
+        if (!ARROW2D_PROFILING)
+            std::cerr << "--trace ignored: built without ARROW2D_PROFILING." << std::endl;
+        else if (Profiler::Instance().ExportChromeTrace(tracePath))
+            std::cout << "Wrote trace to " << tracePath << std::endl;
+    }
 
     engine.Clean(); 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,37 @@
+#include "AnimationLibrary.hpp"
+#include "NPC.hpp"
+#include "TextureManager.hpp"
+#include "Tests.hpp"
+
+namespace
+{
+    const AnimationSetDef TEST_ANIMATION =
+    {
+        {AnimState::IdleLeft,  {{"assets/sprites/Player/Left_Idle.bmp"}, 10.0f, {}}},
+        {AnimState::IdleRight, {{"assets/sprites/Player/Right_Idle.bmp"}, 10.0f, {}}}
+    };
+
+    /// @brief A set lives while objects use it, then goes, releasing its texture handles.
+    void TestSetsReleasedWithLastUser()
+    {
+        AnimationLibrary &library = AnimationLibrary::Instance();
+        TextureManager &textures = TextureManager::Instance();
+        size_t referenced = textures.GetStats().referenced;
+
+        NPC *npc = new NPC(0.0f, 0.0f, 44.0f, 66.0f, library.Load("Test", TEST_ANIMATION), 0.0f);
+        CHECK(library.Find("Test") != nullptr);
+        CHECK(library.Load("Test", {}).get() == npc->GetAnimation()); // Shared while in use
+        CHECK(textures.GetStats().referenced == referenced + 2);
+
+        delete npc;
+        CHECK(library.Find("Test") == nullptr);
+        CHECK(textures.GetStats().referenced == referenced);
+    }
+}
+
+void RunAnimationLibraryTests()
+{
+    TestSetsReleasedWithLastUser();
+    AnimationLibrary::Instance().Clean();
+    TextureManager::Instance().Clean();
+}
@@ -0,0 +1,29 @@
+#include "InputManager.hpp"
+#include "Tests.hpp"
+
+namespace
+{
+    /// @brief A press seen on a frame that runs no simulation step reaches the next step.
+    void TestEdgesLatchedUntilConsumed()
+    {
+        InputManager &input = InputManager::Instance();
+        InputSnapshot tapped;
+        tapped.pressed = Uint32(1) << static_cast<Uint32>(InputAction::MoveUp);
+        tapped.released = tapped.pressed;
+        input.SetSnapshot(tapped);
+
+        input.Update(); // A frame with no step
+        CHECK(input.GetSnapshot().WasPressed(InputAction::MoveUp));
+        CHECK(input.GetSnapshot().WasReleased(InputAction::MoveUp));
+
+        input.ConsumeEdges(); // The step that read them
+        input.Update();
+        CHECK(!input.GetSnapshot().WasPressed(InputAction::MoveUp));
+        CHECK(!input.GetSnapshot().WasReleased(InputAction::MoveUp));
+    }
+}
+
+void RunInputManagerTests()
+{
+    TestEdgesLatchedUntilConsumed();
+}
@@ -0,0 +1,67 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "JobSystem.hpp"
+#include "Tests.hpp"
+
+namespace
+{
+    /// @brief A job queued while a loop runs is left to the workers, not run by the loop's caller.
+    void TestParallelForRunsOnlyItsBatches()
+    {
+        JobSystem &jobs = JobSystem::Instance();
+        jobs.Init(1);
+        const std::thread::id caller = std::this_thread::get_id();
+        std::atomic<bool> ranOnCaller{ false };
+        JobHandle slow;
+        std::vector<int> visited(4096, 0);
+        jobs.ParallelFor(visited.size(), 64, [&](size_t begin, size_t end)
+        {
+            if (begin == 0)
+                slow = jobs.Schedule([&]() { ranOnCaller = std::this_thread::get_id() == caller; });
+            for (size_t i = begin; i < end; ++i)
+                ++visited[i];
+        });
+        bool once = true;
+        for (int v : visited)
+            once = once && v == 1;
+        CHECK(once);
+        CHECK(slow);
+        if (slow)
+        {
+            while (!slow->done.load())
+                std::this_thread::yield();
+        }
+        CHECK(!ranOnCaller);
+        jobs.Shutdown();
+    }
+
+    /// @brief Restarting the pool runs the jobs still queued, so waiting on them returns.
+    void TestInitKeepsQueuedJobs()
+    {
+        JobSystem &jobs = JobSystem::Instance();
+        jobs.Init(2);
+        std::atomic<int> ran{ 0 };
+        std::vector<JobHandle> handles;
+        for (int i = 0; i < 64; ++i)
+        {
+            handles.push_back(jobs.Schedule([&]()
+            {
+                // Queued from a worker, onto its own queue
+                jobs.Schedule([&]() { ++ran; });
+                ++ran;
+            }));
+        }
+        jobs.Init(1);
+        for (const JobHandle &handle : handles)
+            jobs.Wait(handle);
+        jobs.Shutdown();
+        CHECK(ran == 128);
+    }
+}
+
+void RunJobSystemTests()
+{
+    TestParallelForRunsOnlyItsBatches();
+    TestInitKeepsQueuedJobs();
+}
@@ -0,0 +1,19 @@
+#include "SceneFile.hpp"
+#include "Tests.hpp"
+
+namespace
+{
+    /// @brief The optional object speed may be left out even when the line ends in whitespace.
+    void TestObjectTrailingWhitespace()
+    {
+        SceneFile file;
+        CHECK(file.Parse("object npc 0 0 10 10 villager   \nobject npc 20 0 10 10 villager 80\t\r\n", "test"));
+        CHECK(file.GetObjectCount() == 2);
+        CHECK(!file.Parse("object npc 0 0 10 10 villager fast\n", "test"));
+    }
+}
+
+void RunSceneFileTests()
+{
+    TestObjectTrailingWhitespace();
+}
@@ -0,0 +1,50 @@
+#include <filesystem>
+#include "JobSystem.hpp"
+#include "Renderer.hpp"
+#include "SceneFile.hpp"
+#include "SceneManager.hpp"
+#include "TextureManager.hpp"
+#include "Tests.hpp"
+
+namespace
+{
+    /// @brief With no workers, a pushed scene whose textures are ready shows even while other uploads wait.
+    void TestSceneShownWithoutWorkers()
+    {
+        JobSystem::Instance().Init(0);
+        SDL_Renderer *renderer = Renderer::Instance().GetSDLRenderer();
+        TextureManager &textures = TextureManager::Instance();
+        const char *sprite = "assets/sprites/Player/Left_Idle.bmp";
+        TextureHandle used = textures.LoadTexture(sprite, renderer);
+        CHECK(textures.GetStatus(used) == TextureStatus::Ready);
+        TextureHandle unrelated = textures.LoadTextureAsync("assets/sprites/Player/Right_Idle.bmp");
+        CHECK(textures.GetStatus(unrelated) == TextureStatus::Loading);
+
+        const std::string path = (std::filesystem::temp_directory_path() / "arrow2d_test_stack.scn").string();
+        SceneFile file;
+        file.AddSprite(0, sprite, {0.0f, 0.0f, 32.0f, 32.0f});
+        CHECK(file.Save(path));
+
+        SceneManager scenes;
+        scenes.Push(path);
+        for (int step = 0; step < 4 && scenes.IsLoading(); ++step)
+            scenes.Advance();
+        CHECK(!scenes.IsLoading());
+        CHECK(scenes.GetDepth() == 1);
+
+        scenes.Clear();
+        textures.FinishLoading(renderer);
+        std::filesystem::remove(path);
+        JobSystem::Instance().Shutdown();
+    }
+}
+
+void RunSceneManagerTests()
+{
+    if (!InitTestRenderer())
+    {
+        ++testFailures;
+        return;
+    }
+    TestSceneShownWithoutWorkers();
+}
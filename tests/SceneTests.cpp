@@ -0,0 +1,113 @@
+#include <filesystem>
+#include "GameObject.hpp"
+#include "Player.hpp"
+#include "Renderer.hpp"
+#include "Scene.hpp"
+#include "SceneFile.hpp"
+#include "Tests.hpp"
+
+namespace
+{
+    constexpr float TEST_DT = 0.05f;
+
+    /// @brief Moving an object in a scene through its setters sticks, and it collides where it was moved to.
+    void TestSetPositionThenUpdate()
+    {
+        Scene scene;
+        GameObject *moved = new GameObject(0.0f, 0.0f, 10.0f, 10.0f, nullptr);
+        scene.AddObject(moved);
+        moved->SetX(100.0f);
+        moved->SetY(4.0f);
+        scene.Update(TEST_DT);
+        CHECK(moved->GetX() == 100.0f);
+        CHECK(moved->GetY() == 4.0f);
+        CHECK(moved->GetHitbox().x == 100.0f);
+        CHECK(moved->GetHitbox().y == 4.0f);
+
+        // Moves 50 pixels left in one step, into the box's new place; the grid must find it there
+        GameObject *mover = new GameObject(130.0f, 4.0f, 10.0f, 10.0f, nullptr);
+        scene.AddObject(mover);
+        mover->SetVX(-50.0f / TEST_DT);
+        scene.Update(TEST_DT);
+        CHECK(mover->GetX() == 110.0f);
+
+        // Despawning after a move must take the object out of the cells it is now in
+        scene.Despawn(moved);
+        scene.Update(TEST_DT);
+        CHECK(mover->GetX() < 110.0f);
+    }
+
+    /// @brief Setting the hitbox of an object in a scene moves the object with it.
+    void TestSetHitboxThenUpdate()
+    {
+        Scene scene;
+        GameObject *obj = new GameObject(0.0f, 0.0f, 10.0f, 10.0f, nullptr);
+        scene.AddObject(obj);
+        obj->SetHitbox({200.0f, 30.0f, 10.0f, 10.0f});
+        scene.Update(TEST_DT);
+        CHECK(obj->GetX() == 200.0f);
+        CHECK(obj->GetY() == 30.0f);
+    }
+
+    /// @brief Regions stream around the simulated player on each step, with no frame rendered.
+    void TestWorldStreamsOnUpdate()
+    {
+        const float regionSize = 1024.0f;
+        const std::filesystem::path dir = std::filesystem::temp_directory_path();
+        const std::string nearPath = (dir / "arrow2d_test_near.scn").string();
+        const std::string farPath = (dir / "arrow2d_test_far.scn").string();
+        SceneFile region;
+        region.AddObject(SceneObjectType::NPC, 100.0f, 100.0f, 10.0f, 10.0f, "");
+        CHECK(region.Save(nearPath));
+        region.Clear();
+        region.AddObject(SceneObjectType::NPC, 8 * regionSize + 100.0f, 100.0f, 10.0f, 10.0f, "");
+        CHECK(region.Save(farPath));
+
+        Scene scene;
+        Player *player = new Player(0.0f, 0.0f, 10.0f, 10.0f, nullptr);
+        scene.AddObject(player);
+        WorldStreamer &world = scene.GetWorld();
+        world.SetSynchronous(true);
+        world.SetRegionSize(regionSize);
+        world.AddRegion(0, 0, nearPath);
+        world.AddRegion(8, 0, farPath);
+
+        scene.Update(TEST_DT);
+        CHECK(world.GetStats().loaded == 1);
+        CHECK(world.GetStats().objects == 1);
+
+        player->SetX(8 * regionSize);
+        scene.Update(TEST_DT);
+        CHECK(world.GetStats().loaded == 1);
+        CHECK(world.GetStats().objects == 1);
+        CHECK(world.GetStats().removed == 1);
+
+        world.Clear(scene);
+        std::filesystem::remove(nearPath);
+        std::filesystem::remove(farPath);
+    }
+
+    /// @brief Only objects outside the view count as culled, not objects with nothing to draw.
+    void TestCulledCountsViewRejections()
+    {
+        if (!InitTestRenderer())
+        {
+            ++testFailures;
+            return;
+        }
+        Scene scene;
+        scene.AddObject(new GameObject(10.0f, 10.0f, 10.0f, 10.0f, nullptr));
+        scene.AddObject(new GameObject(100000.0f, 10.0f, 10.0f, 10.0f, nullptr));
+        scene.Render(Renderer::Instance(), 1.0f);
+        CHECK(scene.GetRenderStats().drawn == 0);
+        CHECK(scene.GetRenderStats().culled == 1);
+    }
+}
+
+void RunSceneTests()
+{
+    TestSetPositionThenUpdate();
+    TestSetHitboxThenUpdate();
+    TestWorldStreamsOnUpdate();
+    TestCulledCountsViewRejections();
+}
@@ -0,0 +1,42 @@
+#ifndef TESTS_HPP
+#define TESTS_HPP
+
+#include <iostream>
+
+/**
+ * Shared helpers for the Arrow2D_tests executable.
+ *
+ * Each test file exposes one Run*Tests() entry point that main() calls in turn. CHECK() prints
+ * every failed condition with its location and counts it; the executable fails if any did, so
+ * ctest reports it. Tests run from the repository root so the sprite assets can be found.
+ */
+
+/// @brief Number of CHECK() conditions that have failed so far.
+extern int testFailures;
+
+#define CHECK(condition)                                                                          \
+    do                                                                                            \
+    {                                                                                             \
+        if (!(condition))                                                                         \
+        {                                                                                         \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" << std::endl; \
+            ++testFailures;                                                                       \
+        }                                                                                         \
+    } while (false)
+
+/**
+ * @brief Creates an offscreen software renderer and installs it in the Renderer singleton.
+ * @return true on success.
+ */
+bool InitTestRenderer();
+
+void RunJobSystemTests();
+void RunTextureAtlasTests();
+void RunTextureManagerTests();
+void RunAnimationLibraryTests();
+void RunSceneTests();
+void RunInputManagerTests();
+void RunSceneFileTests();
+void RunSceneManagerTests();
+
+#endif // TESTS_HPP
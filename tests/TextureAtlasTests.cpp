@@ -0,0 +1,54 @@
+#include <vector>
+#include "Renderer.hpp"
+#include "TextureAtlas.hpp"
+#include "Tests.hpp"
+
+namespace
+{
+    constexpr int TEST_PAGE_SIZE = 128;
+    constexpr int TEST_PADDING = 2;
+    constexpr int TEST_IMAGE_SIZE = 28; // Four per row and column with padding
+
+    /// @brief Space released on a partly used page is packed into again instead of growing the atlas.
+    void TestReleasedSpaceReused()
+    {
+        SDL_Renderer *renderer = Renderer::Instance().GetSDLRenderer();
+        SDL_Surface *image = SDL_CreateSurface(TEST_IMAGE_SIZE, TEST_IMAGE_SIZE, SDL_PIXELFORMAT_RGBA32);
+        CHECK(image);
+        if (!image)
+            return;
+        TextureAtlas atlas(TEST_PAGE_SIZE, TEST_PADDING);
+        std::vector<TextureRegion> regions;
+        TextureRegion region;
+        CHECK(atlas.Add(image, renderer, region));
+        regions.push_back(region);
+        while (atlas.Add(image, renderer, region, false))
+            regions.push_back(region);
+        CHECK(atlas.GetPageCount() == 1);
+        CHECK(regions.size() >= 4);
+
+        // Free two neighbours: each gap fits its old image, and together they fit a wider one
+        atlas.Release(regions[0]);
+        atlas.Release(regions[1]);
+        for (int i = 0; i < 2; ++i)
+            CHECK(atlas.Add(image, renderer, region, false));
+        CHECK(!atlas.Add(image, renderer, region, false));
+        atlas.Release(regions[2]);
+        atlas.Release(regions[3]);
+        SDL_Surface *wide = SDL_CreateSurface(2 * TEST_IMAGE_SIZE + TEST_PADDING, TEST_IMAGE_SIZE, SDL_PIXELFORMAT_RGBA32);
+        CHECK(wide && atlas.Add(wide, renderer, region, false));
+        CHECK(atlas.GetPageCount() == 1);
+        SDL_DestroySurface(wide);
+        SDL_DestroySurface(image);
+    }
+}
+
+void RunTextureAtlasTests()
+{
+    if (!InitTestRenderer())
+    {
+        ++testFailures;
+        return;
+    }
+    TestReleasedSpaceReused();
+}
@@ -0,0 +1,137 @@
+#include <filesystem>
+#include "JobSystem.hpp"
+#include "Renderer.hpp"
+#include "TextureManager.hpp"
+#include "Tests.hpp"
+
+namespace
+{
+    /// @brief With no workers, async loads must still decode and upload within a frame or two.
+    void TestZeroWorkerUploads()
+    {
+        JobSystem::Instance().Init(0);
+        CHECK(JobSystem::Instance().GetWorkerCount() == 0);
+        SDL_Renderer *renderer = Renderer::Instance().GetSDLRenderer();
+        TextureManager &textures = TextureManager::Instance();
+
+        TextureHandle left = textures.LoadTextureAsync("assets/sprites/Player/Left_Idle.bmp");
+        TextureHandle right = textures.LoadTextureAsync("assets/sprites/Player/Right_Idle.bmp");
+        for (int frame = 0; frame < 4 && textures.GetPendingCount() > 0; ++frame)
+            textures.ProcessUploads(renderer, TEXTURE_UPLOAD_BUDGET_BYTES);
+        CHECK(textures.GetPendingCount() == 0);
+        CHECK(textures.GetStatus(left) == TextureStatus::Ready);
+        CHECK(textures.GetStatus(right) == TextureStatus::Ready);
+        JobSystem::Instance().Shutdown();
+    }
+
+    /// @brief With no workers, each call decodes only what its budget allows, oldest request first.
+    void TestZeroWorkerDecodeBudget()
+    {
+        JobSystem::Instance().Init(0);
+        SDL_Renderer *renderer = Renderer::Instance().GetSDLRenderer();
+        TextureManager &textures = TextureManager::Instance();
+        textures.Clean();
+
+        // The last image is deleted after the first call, so it only loads if it was decoded early
+        const std::string late = (std::filesystem::temp_directory_path() / "arrow2d_test_late.bmp").string();
+        std::filesystem::copy_file("assets/sprites/Player/Left_Idle.bmp", late, std::filesystem::copy_options::overwrite_existing);
+        const std::string paths[] = { "assets/sprites/Player/Left_Idle.bmp", "assets/sprites/Player/Right_Idle.bmp", late };
+        TextureHandle handles[3];
+        for (int i = 0; i < 3; ++i)
+            handles[i] = textures.LoadTextureAsync(paths[i]);
+        bool otherJobRan = false;
+        JobHandle other = JobSystem::Instance().Schedule([&]() { otherJobRan = true; });
+
+        // A one-byte budget still decodes and uploads one image, and only one
+        CHECK(textures.ProcessUploads(renderer, 1) == 1);
+        CHECK(textures.GetStatus(handles[0]) == TextureStatus::Ready);
+        CHECK(textures.GetStatus(handles[1]) == TextureStatus::Loading);
+        CHECK(!otherJobRan);
+        std::filesystem::remove(late);
+        CHECK(textures.ProcessUploads(renderer, 1) == 1);
+        CHECK(textures.GetStatus(handles[1]) == TextureStatus::Ready);
+        CHECK(textures.ProcessUploads(renderer, 1) == 1);
+        CHECK(textures.GetStatus(handles[2]) == TextureStatus::Failed);
+        CHECK(textures.GetPendingCount() == 0);
+        JobSystem::Instance().Wait(other);
+        JobSystem::Instance().Shutdown();
+    }
+
+    /// @brief Loading a texture that is already streaming in finishes only that load.
+    void TestLoadFinishesOnlyItsEntry()
+    {
+        SDL_Renderer *renderer = Renderer::Instance().GetSDLRenderer();
+        TextureManager &textures = TextureManager::Instance();
+        textures.Clean();
+        for (int workers : { 0, 2 })
+        {
+            JobSystem::Instance().Init(workers);
+            TextureHandle left = textures.LoadTextureAsync("assets/sprites/Player/Left_Idle.bmp");
+            TextureHandle right = textures.LoadTextureAsync("assets/sprites/Player/Right_Idle.bmp");
+            CHECK(textures.LoadTexture("assets/sprites/Player/Right_Idle.bmp", renderer) == right);
+            CHECK(textures.GetStatus(right) == TextureStatus::Ready);
+            CHECK(textures.GetStatus(left) == TextureStatus::Loading);
+            CHECK(textures.GetPendingCount() == 1);
+            textures.FinishLoading(renderer);
+            CHECK(textures.GetStatus(left) == TextureStatus::Ready);
+            JobSystem::Instance().Shutdown();
+            left = TextureHandle();
+            right = TextureHandle();
+            textures.Clean();
+        }
+    }
+
+    /// @brief The budget bounds GPU memory: evicting the last image frees its page, which the placeholder does not pin.
+    void TestBudgetFreesPages()
+    {
+        SDL_Renderer *renderer = Renderer::Instance().GetSDLRenderer();
+        TextureManager &textures = TextureManager::Instance();
+        textures.Clean();
+        TextureHandle handle = textures.LoadTexture("assets/sprites/Player/Left_Idle.bmp", renderer);
+        CHECK(textures.GetStatus(handle) == TextureStatus::Ready);
+        CHECK(textures.GetStats().gpuBytes > 0);
+        handle = TextureHandle();
+        textures.SetBudget(0);
+        CHECK(textures.GetStats().gpuBytes == 0);
+        CHECK(textures.GetStats().textures == 0);
+        textures.SetBudget(TEXTURE_MEMORY_BUDGET_BYTES);
+    }
+
+    /// @brief A texture that failed to load is forgotten once nobody holds it, so it is retried.
+    void TestFailedEntriesFreed()
+    {
+        SDL_Renderer *renderer = Renderer::Instance().GetSDLRenderer();
+        TextureManager &textures = TextureManager::Instance();
+        const char *missing = "assets/sprites/Missing.bmp";
+
+        TextureHandle handle = textures.LoadTexture(missing, renderer);
+        CHECK(textures.GetStatus(handle) == TextureStatus::Failed);
+        Uint64 misses = textures.GetStats().misses;
+        TextureHandle again = textures.LoadTexture(missing, renderer);
+        CHECK(again == handle); // Still referenced: the failed entry is reused
+        CHECK(textures.GetStats().misses == misses);
+
+        handle = TextureHandle();
+        again = TextureHandle();
+        textures.ProcessUploads(renderer, TEXTURE_UPLOAD_BUDGET_BYTES);
+        TextureHandle retried = textures.LoadTexture(missing, renderer);
+        CHECK(textures.GetStats().misses == misses + 1);
+        CHECK(textures.GetStatus(retried) == TextureStatus::Failed);
+    }
+}
+
+void RunTextureManagerTests()
+{
+    if (!InitTestRenderer())
+    {
+        std::cerr << "Could not create the test renderer: " << SDL_GetError() << std::endl;
+        ++testFailures;
+        return;
+    }
+    TestZeroWorkerUploads();
+    TestZeroWorkerDecodeBudget();
+    TestLoadFinishesOnlyItsEntry();
+    TestBudgetFreesPages();
+    TestFailedEntriesFreed();
+    TextureManager::Instance().Clean();
+}
@@ -0,0 +1,38 @@
+#include <iostream>
+#include "Renderer.hpp"
+#include "Tests.hpp"
+
+int testFailures = 0;
+
+bool InitTestRenderer()
+{
+    if (Renderer::Instance().GetSDLRenderer())
+        return true;
+    SDL_Surface *target = SDL_CreateSurface(320, 240, SDL_PIXELFORMAT_ARGB8888);
+    return target && Renderer::Instance().Init(SDL_CreateSoftwareRenderer(target));
+}
+
+/**
+ * Arrow2D regression tests.
+ *
+ * Usage: Arrow2D_tests, from the repository root (ctest sets the working directory).
+ */
+int main()
+{
+    RunJobSystemTests();
+    RunTextureAtlasTests();
+    RunTextureManagerTests();
+    RunAnimationLibraryTests();
+    RunSceneTests();
+    RunInputManagerTests();
+    RunSceneFileTests();
+    RunSceneManagerTests();
+
+    if (testFailures > 0)
+    {
+        std::cerr << testFailures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AssetArchive.hpp"
+#include "SceneFile.hpp"
+
+/**
+ * Arrow2D asset packer.
+ *
+ * Usage: Arrow2D_pack <output.pak> <file or directory>...
+ *
+ * Directories are packed recursively. Each asset is keyed by its path exactly as given on the
+ * command line (run from the project root and pass "assets" so keys match the paths the game
+ * loads). BMP images are decoded and stored as RGBA32 pixels ready for upload, and .scene files
+ * are compiled to their binary form under the same key; everything else is stored as raw bytes.
+ */
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    /// @brief An asset waiting to be written.
+    struct PackedAsset
+    {
+        std::string key;
+        ArchiveEntry entry;
+        std::vector<Uint8> payload;
+    };
+
+    std::string Extension(const fs::path &path)
+    {
+        std::string ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return ext;
+    }
+
+    bool LoadImage(const fs::path &path, PackedAsset &asset)
+    {
+        SDL_Surface *loaded = SDL_LoadBMP(path.string().c_str());
+        if (!loaded)
+        {
+            std::cerr << "Failed to load " << path.string() << ": " << SDL_GetError() << std::endl;
+            return false;
+        }
+        SDL_Surface *surface = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(loaded);
+        if (!surface)
+        {
+            std::cerr << "Failed to convert " << path.string() << ": " << SDL_GetError() << std::endl;
+            return false;
+        }
+
+        // Store rows tightly packed, dropping any pitch padding
+        Uint32 rowBytes = static_cast<Uint32>(surface->w) * 4;
+        asset.entry.type = ArchiveEntryType::Image;
+        asset.entry.format = SDL_PIXELFORMAT_RGBA32;
+        asset.entry.width = static_cast<Uint32>(surface->w);
+        asset.entry.height = static_cast<Uint32>(surface->h);
+        asset.entry.pitch = rowBytes;
+        asset.payload.resize(static_cast<size_t>(rowBytes) * surface->h);
+        for (int y = 0; y < surface->h; ++y)
+            std::memcpy(asset.payload.data() + static_cast<size_t>(y) * rowBytes, static_cast<const Uint8 *>(surface->pixels) + static_cast<size_t>(y) * surface->pitch, rowBytes);
+        SDL_DestroySurface(surface);
+        return true;
+    }
+
+    bool LoadRaw(const fs::path &path, PackedAsset &asset)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            std::cerr << "Failed to open " << path.string() << std::endl;
+            return false;
+        }
+        asset.entry.type = ArchiveEntryType::Raw;
+        asset.payload.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    bool LoadScene(const fs::path &path, PackedAsset &asset)
+    {
+        if (!LoadRaw(path, asset))
+            return false;
+        SceneFile scene;
+        if (!scene.Parse(std::string(asset.payload.begin(), asset.payload.end()), path.string()))
+        {
+            std::cerr << "Failed to compile " << path.string() << std::endl;
+            return false;
+        }
+        asset.payload = scene.Compile();
+        return true;
+    }
+
+    void WritePadding(std::ofstream &out, Uint64 &offset)
+    {
+        static const char zeros[ARCHIVE_ALIGNMENT] = {};
+        Uint64 aligned = (offset + ARCHIVE_ALIGNMENT - 1) / ARCHIVE_ALIGNMENT * ARCHIVE_ALIGNMENT;
+        out.write(zeros, static_cast<std::streamsize>(aligned - offset));
+        offset = aligned;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <output.pak> <file or directory>..." << std::endl;
+        return 1;
+    }
+
+    std::vector<fs::path> files;
+    for (int i = 2; i < argc; ++i)
+    {
+        fs::path input = argv[i];
+        if (fs::is_directory(input))
+        {
+            for (const fs::directory_entry &entry : fs::recursive_directory_iterator(input))
+                if (entry.is_regular_file())
+                    files.push_back(entry.path());
+        }
+        else if (fs::is_regular_file(input))
+            files.push_back(input);
+        else
+        {
+            std::cerr << "No such file or directory: " << input.string() << std::endl;
+            return 1;
+        }
+    }
+    std::sort(files.begin(), files.end()); // Same inputs, same archive
+
+    std::vector<PackedAsset> assets;
+    for (const fs::path &file : files)
+    {
+        PackedAsset asset;
+        asset.key = file.generic_string();
+        asset.entry = {};
+        asset.entry.hash = AssetArchive::HashPath(asset.key);
+        std::string ext = Extension(file);
+        bool loaded = ext == ".bmp" ? LoadImage(file, asset)
+                    : ext == ".scene" ? LoadScene(file, asset)
+                    : LoadRaw(file, asset);
+        if (!loaded)
+            return 1;
+        asset.entry.size = asset.payload.size();
+        assets.push_back(std::move(asset));
+    }
+
+    // Keep the table at most half full so lookups rarely probe more than one slot
+    Uint32 slots = 16;
+    while (slots < assets.size() * 2)
+        slots *= 2;
+
+    std::ofstream out(argv[1], std::ios::binary);
+    if (!out)
+    {
+        std::cerr << "Failed to create " << argv[1] << std::endl;
+        return 1;
+    }
+    ArchiveHeader header = {};
+    std::memcpy(header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    header.version = ARCHIVE_VERSION;
+    header.entryCount = static_cast<Uint32>(assets.size());
+    header.tableSlots = slots;
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    Uint64 offset = sizeof(header);
+    for (PackedAsset &asset : assets)
+    {
+        WritePadding(out, offset);
+        asset.entry.offset = offset;
+        out.write(reinterpret_cast<const char *>(asset.payload.data()), static_cast<std::streamsize>(asset.payload.size()));
+        offset += asset.payload.size();
+    }
+
+    std::vector<ArchiveEntry> table(slots, ArchiveEntry{});
+    for (const PackedAsset &asset : assets)
+    {
+        Uint32 i = static_cast<Uint32>(asset.entry.hash) & (slots - 1);
+        while (table[i].hash != 0)
+        {
+            if (table[i].hash == asset.entry.hash)
+            {
+                std::cerr << "Hash collision on " << asset.key << "; rename the file" << std::endl;
+                return 1;
+            }
+            i = (i + 1) & (slots - 1);
+        }
+        table[i] = asset.entry;
+    }
+    WritePadding(out, offset);
+    header.tableOffset = offset;
+    out.write(reinterpret_cast<const char *>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(ArchiveEntry)));
+    out.seekp(0);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (!out)
+    {
+        std::cerr << "Failed to write " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::cout << "Packed " << assets.size() << " assets into " << argv[1] << " (" << offset + table.size() * sizeof(ArchiveEntry) << " bytes)" << std::endl;
+    return 0;
+}